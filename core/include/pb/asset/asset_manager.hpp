@@ -0,0 +1,332 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <pb/meta/hash.hpp>
+#include <pb/platform/file_watcher.hpp>
+#include <pb/utility/pack.hpp>
+
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+
+#include <nlohmann/json.hpp>
+
+namespace pb::core::asset
+{
+	enum class AssetState : std::uint8_t
+	{
+		// queued or being decoded / uploaded
+		LOADING,
+		// the value can be used
+		READY,
+		// the file cannot be read or decoded, see the log
+		FAILED,
+	};
+
+	namespace asset_manager_detail
+	{
+		struct texture_deleter
+		{
+			auto operator()(SDL_Texture* texture) const noexcept -> void
+			{
+				SDL_DestroyTexture(texture);
+			}
+		};
+
+		struct font_deleter
+		{
+			auto operator()(TTF_Font* font) const noexcept -> void
+			{
+				TTF_CloseFont(font);
+			}
+		};
+	}
+
+	struct Texture
+	{
+		std::unique_ptr<SDL_Texture, asset_manager_detail::texture_deleter> texture;
+		float width;
+		float height;
+		// 0 for the image itself, otherwise the largest side of a downscaled copy (see `AssetManager::load_thumbnail`)
+		std::uint32_t thumbnail;
+	};
+
+	struct Font
+	{
+		// TTF_Font reads the glyphs from this buffer (empty if the font is read in place from a pack), declared first so it outlives `font`
+		std::vector<std::byte> data;
+		std::unique_ptr<TTF_Font, asset_manager_detail::font_deleter> font;
+		float size;
+	};
+
+	struct Json
+	{
+		nlohmann::json value;
+	};
+
+	namespace asset_manager_detail
+	{
+		template<typename T>
+		struct Slot
+		{
+			infra::meta::hash_type hash;
+			std::filesystem::path path;
+			std::atomic<AssetState> state;
+			// written and read on the main thread only, valid once `state` is READY
+			T value;
+			// incremented on the main thread every time `value` is (re)loaded
+			std::uint32_t version;
+		};
+	}
+
+	/**
+	 * @brief Reference counted handle of an asset, cheap to copy.
+	 *
+	 * The asset is released by `AssetManager::collect` once no handle refers to it anymore.
+	 */
+	template<typename T>
+	class Handle
+	{
+	public:
+		using value_type = T;
+		using slot_type = asset_manager_detail::Slot<value_type>;
+
+	private:
+		std::shared_ptr<slot_type> slot_;
+
+	public:
+		Handle() noexcept = default;
+
+		explicit Handle(std::shared_ptr<slot_type> slot) noexcept
+			: slot_{std::move(slot)} {}
+
+		[[nodiscard]] explicit operator bool() const noexcept
+		{
+			return slot_ != nullptr;
+		}
+
+		[[nodiscard]] auto state() const noexcept -> AssetState
+		{
+			return slot_ == nullptr ? AssetState::FAILED : slot_->state.load(std::memory_order_acquire);
+		}
+
+		[[nodiscard]] auto ready() const noexcept -> bool
+		{
+			return state() == AssetState::READY;
+		}
+
+		// nullptr until the asset is READY, main thread only
+		[[nodiscard]] auto get() const noexcept -> const value_type*
+		{
+			return ready() ? &slot_->value : nullptr;
+		}
+
+		[[nodiscard]] auto path() const noexcept -> const std::filesystem::path&
+		{
+			return slot_->path;
+		}
+
+		// changes every time the asset is reloaded, main thread only
+		[[nodiscard]] auto version() const noexcept -> std::uint32_t
+		{
+			return slot_->version;
+		}
+
+		[[nodiscard]] auto hash() const noexcept -> infra::meta::hash_type
+		{
+			return slot_->hash;
+		}
+
+		[[nodiscard]] auto operator==(const Handle& other) const noexcept -> bool
+		{
+			return slot_ == other.slot_;
+		}
+	};
+
+	struct UploadBudget
+	{
+		// main thread time spent in uploads per `update`
+		std::chrono::nanoseconds time{std::chrono::milliseconds{2}};
+		// bytes handed to the renderer per `update`
+		std::size_t bytes{8 * 1024 * 1024};
+	};
+
+	/**
+	 * @brief Loads textures (SDL3_image), fonts (SDL3_ttf) and JSON documents (nlohmann::json) in the background.
+	 *
+	 * Files are read and decoded on worker threads, the renderer-side part (texture creation, font opening) is queued
+	 * and drained by `update` on the main thread within a per-frame budget, so streaming a level does not stall the present cadence.
+		 * Requests for the same file share one asset (keyed by the hash of the normalized path).
+	 * Files are looked up in the mounted packs first (see `mount`), then in the file system.
+	 *
+	 * @code
+	 * AssetManager assets{renderer};
+	 * const auto player = assets.load_texture("assets/player.png");
+	 *
+	 * while (running)
+	 * {
+	 *     assets.update();
+	 *     if (const auto* texture = player.get()) { SDL_RenderTexture(renderer, texture->texture.get(), nullptr, &rect); }
+	 * }
+	 * @endcode
+	 *
+	 * @note All member functions must be called from the main (rendering) thread, handles must not outlive the manager.
+	 */
+	class AssetManager
+	{
+	public:
+		using size_type = std::size_t;
+
+		template<typename T>
+		using map_type = std::unordered_map<infra::meta::hash_type, std::shared_ptr<asset_manager_detail::Slot<T>>>;
+
+	private:
+		struct file_type
+		{
+			// empty if the file is mapped from a pack
+			std::vector<std::byte> storage;
+			std::span<const std::byte> bytes;
+		};
+
+		struct upload_type
+		{
+			// accounted against `UploadBudget::bytes`
+			size_type bytes;
+			std::move_only_function<auto(SDL_Renderer*) -> void> commit;
+		};
+
+		SDL_Renderer* renderer_;
+
+		// declared before the assets, fonts and decoders read the mapped bytes in place
+		mutable std::shared_mutex packs_mutex_;
+		std::vector<infra::utility::Pack> packs_;
+
+		map_type<Texture> textures_;
+		map_type<Font> fonts_;
+		map_type<Json> jsons_;
+
+		std::mutex decode_mutex_;
+		std::condition_variable_any decode_condition_;
+		std::deque<std::move_only_function<auto() -> void>> decode_queue_;
+
+		std::mutex upload_mutex_;
+		std::deque<upload_type> upload_queue_;
+
+		// assets in LOADING state
+		std::atomic<size_type> pending_;
+
+		std::optional<infra::platform::FileWatcher> watcher_;
+		std::vector<std::filesystem::path> changed_;
+
+		// last member, the workers are stopped and joined before the queues are destroyed
+		std::vector<std::jthread> workers_;
+
+		// the bytes of `path` in the last mounted pack that has it
+		[[nodiscard]] auto locate(const std::filesystem::path& path, file_type& file) const -> bool;
+
+		// a stream over the mapped entry of `path`, or over the file itself (always with `bypass_packs`)
+		[[nodiscard]] auto open(const std::filesystem::path& path, bool bypass_packs) const -> SDL_IOStream*;
+
+		[[nodiscard]] auto read(const std::filesystem::path& path, bool bypass_packs) const -> std::optional<file_type>;
+
+		auto work(std::stop_token stop_token) noexcept -> void;
+
+		auto decode(std::move_only_function<auto() -> void> job) -> void;
+
+		auto upload(size_type bytes, std::move_only_function<auto(SDL_Renderer*) -> void> commit) -> void;
+
+		auto fail(std::atomic<AssetState>& state, const std::filesystem::path& path, const char* reason) noexcept -> void;
+
+		// `bypass_packs` reads the file system even if a mounted pack has the file (hot reload)
+		auto decode_texture(std::shared_ptr<asset_manager_detail::Slot<Texture>> slot, bool bypass_packs = false) -> void;
+
+		auto decode_font(std::shared_ptr<asset_manager_detail::Slot<Font>> slot, bool bypass_packs = false) -> void;
+
+		auto decode_json(std::shared_ptr<asset_manager_detail::Slot<Json>> slot, bool bypass_packs = false) -> void;
+
+	public:
+		[[nodiscard]] static auto default_worker_count() noexcept -> size_type;
+
+		// the key of `path` (and `seed`, e.g. the size of a font) used to share assets
+		[[nodiscard]] static auto hash_of(const std::filesystem::path& path, infra::meta::hash_type seed = 0) noexcept -> infra::meta::hash_type;
+
+		explicit AssetManager(SDL_Renderer* renderer, size_type worker_count = default_worker_count());
+
+		AssetManager(const AssetManager&) = delete;
+		AssetManager(AssetManager&&) = delete;
+		auto operator=(const AssetManager&) -> AssetManager& = delete;
+		auto operator=(AssetManager&&) -> AssetManager& = delete;
+
+		~AssetManager() noexcept;
+
+		/**
+		 * @brief Serve the entries of `pack` before the file system, later mounts take precedence.
+		 *
+		 * Entries are decoded straight from the mapping (`SDL_IOFromConstMem`), nothing is copied.
+		 * @note Assets that are already loaded are not affected.
+		 */
+		auto mount(infra::utility::Pack pack) -> void;
+
+		[[nodiscard]] auto load_texture(const std::filesystem::path& path) -> Handle<Texture>;
+
+		/**
+		 * @brief A copy of the image at `path` downscaled so its largest side is at most `size` pixels.
+		 *
+		 * Thumbnails are tiny and cheap to keep resident, e.g. as placeholders of streamed textures (see `TextureCache`).
+		 */
+		[[nodiscard]] auto load_thumbnail(const std::filesystem::path& path, std::uint32_t size) -> Handle<Texture>;
+
+		[[nodiscard]] auto load_font(const std::filesystem::path& path, float size) -> Handle<Font>;
+
+		[[nodiscard]] auto load_json(const std::filesystem::path& path) -> Handle<Json>;
+
+		/**
+		 * @brief Watch the source file of every asset (loaded now or later) and reload the assets whose file is written.
+		 *
+		 * The new value is decoded in the background like a first load and swapped in by `update`, between two frames,
+		 * the asset keeps its previous value meanwhile (and if the new file cannot be decoded), see `Handle::version`.
+		 * Reloaded assets are read from the file system, even if a mounted pack has them.
+		 * @throw infra::platform::OsError if the file watcher cannot be created.
+		 */
+		auto enable_hot_reload() -> void;
+
+		// decode the assets loaded from `path` again from the file system (not from the packs), @return the number of reloaded assets
+		auto reload(const std::filesystem::path& path) -> size_type;
+
+		// assets still decoding or waiting for their upload
+		[[nodiscard]] auto pending() const noexcept -> size_type;
+
+		/**
+		 * @brief Commit decoded assets to the renderer, once per frame before drawing.
+		 *
+		 * With hot reload enabled, the changed source files are reported and their assets queued first.
+		 * At least one upload is committed per call so a single large texture cannot starve.
+		 * @return the number of committed uploads.
+		 */
+		auto update(const UploadBudget& budget = {}) -> size_type;
+
+		// release the assets no handle refers to anymore
+		auto collect() -> size_type;
+	};
+}
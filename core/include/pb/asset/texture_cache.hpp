@@ -0,0 +1,111 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <unordered_map>
+#include <vector>
+
+#include <pb/asset/asset_manager.hpp>
+
+#include <SDL3/SDL.h>
+
+namespace pb::core::asset
+{
+	/**
+	 * @brief Keeps the textures drawn recently resident within a memory budget.
+	 *
+	 * Every texture has a tiny placeholder (a thumbnail, always resident) that is drawn while the texture itself is (re)loaded.
+	 * When the resident textures exceed the budget, the least recently drawn ones are released, they are loaded again on the next `acquire`.
+	 *
+	 * @code
+	 * TextureCache textures{assets, 256 * 1024 * 1024};
+	 * const auto tree = textures.id("assets/tree.png");
+	 *
+	 * while (running)
+	 * {
+	 *     assets.update();
+	 *     textures.update();
+	 *
+	 *     if (auto* texture = textures.acquire(tree)) { SDL_RenderTexture(renderer, texture, nullptr, &rect); }
+	 * }
+	 * @endcode
+	 *
+	 * @note A texture is only freed if nothing else holds a handle to it.
+	 */
+	class TextureCache
+	{
+	public:
+		using size_type = std::size_t;
+		using id_type = std::uint32_t;
+		using frame_type = std::uint64_t;
+
+		constexpr static std::uint32_t default_placeholder_size = 32;
+
+	private:
+		struct entry_type
+		{
+			std::filesystem::path path;
+			// empty while evicted
+			Handle<Texture> texture;
+			Handle<Texture> placeholder;
+			// accounted bytes of `texture`, 0 until it is READY
+			size_type bytes;
+			// `Handle::version` of the accounted texture, a reloaded texture may have another size
+			std::uint32_t version;
+			// `frame_` of the last `acquire`
+			frame_type last_used;
+		};
+
+		AssetManager* assets_;
+
+		size_type budget_;
+		std::uint32_t placeholder_size_;
+
+		std::vector<entry_type> entries_;
+		std::unordered_map<infra::meta::hash_type, id_type> ids_;
+
+		// entries with a texture handle (resident or loading)
+		std::vector<id_type> resident_;
+		size_type resident_bytes_;
+
+		frame_type frame_;
+
+	public:
+		TextureCache(AssetManager& assets, size_type budget, std::uint32_t placeholder_size = default_placeholder_size);
+
+		// the id of `path` (registered once), its placeholder is loaded right away
+		[[nodiscard]] auto id(const std::filesystem::path& path) -> id_type;
+
+		[[nodiscard]] auto path(id_type id) const noexcept -> const std::filesystem::path&;
+
+		/**
+		 * @brief The texture to draw for `id` this frame, marks it as used.
+		 *
+		 * Loads the texture if it was evicted (or never drawn), returns the placeholder meanwhile (nullptr if the placeholder is not ready yet either).
+		 */
+		[[nodiscard]] auto acquire(id_type id) -> SDL_Texture*;
+
+		// the texture of `id` is loaded and accounted
+		[[nodiscard]] auto resident(id_type id) const noexcept -> bool;
+
+		[[nodiscard]] auto budget() const noexcept -> size_type;
+
+		auto set_budget(size_type budget) noexcept -> void;
+
+		[[nodiscard]] auto resident_bytes() const noexcept -> size_type;
+
+		/**
+		 * @brief Account the textures that became READY and evict the least recently drawn ones until the budget is met.
+		 *
+		 * Call once per frame after `AssetManager::update`, textures drawn during the previous frame are never evicted.
+		 * @return the number of evicted textures.
+		 */
+		auto update() -> size_type;
+	};
+}
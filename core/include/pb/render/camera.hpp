@@ -0,0 +1,95 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <pb/math/aabb.hpp>
+#include <pb/math/angle.hpp>
+#include <pb/math/position.hpp>
+#include <pb/render/transform.hpp>
+
+#include <glm/vec2.hpp>
+
+namespace pb::core::render
+{
+	/**
+	 * @brief 2D camera looking at `position` (world space), rotated by `rotation` and scaled by `zoom`, over a viewport of the logical size of the renderer.
+	 *
+	 * `view` is the world space AABB of what the camera sees (the bounds of the rotated viewport), anything outside of it can be skipped before it is batched:
+	 * @code
+	 * Camera2D camera{{1920, 1080}};
+	 * camera.set_position(player.position());
+	 *
+	 * tilemap.render(renderer, camera);
+	 * particles.set_camera(&camera);
+	 * if (camera.visible(enemy.bounds())) { buffer.sprite(order, texture, camera, enemy.rect()); }
+	 * @endcode
+	 */
+	class Camera2D
+	{
+	public:
+		using value_type = float;
+
+	private:
+		// logical size of the renderer
+		glm::vec2 viewport_;
+
+		// world position at the center of the viewport
+		math::Position position_;
+		math::Angle rotation_;
+		value_type zoom_;
+
+		Transform2D world_to_screen_;
+		Transform2D screen_to_world_;
+		math::AABB view_;
+
+		auto refresh() noexcept -> void;
+
+	public:
+		explicit Camera2D(
+			const glm::vec2& viewport,
+			const math::Position& position = {0, 0},
+			math::Angle rotation = math::Angle::zero(),
+			value_type zoom = 1
+		) noexcept;
+
+		[[nodiscard]] auto viewport() const noexcept -> const glm::vec2&;
+
+		auto set_viewport(const glm::vec2& viewport) noexcept -> void;
+
+		[[nodiscard]] auto position() const noexcept -> const math::Position&;
+
+		auto set_position(const math::Position& position) noexcept -> void;
+
+		// move by `offset` in world space
+		auto move(const glm::vec2& offset) noexcept -> void;
+
+		[[nodiscard]] auto rotation() const noexcept -> math::Angle;
+
+		auto set_rotation(math::Angle rotation) noexcept -> void;
+
+		// > 1 magnifies
+		[[nodiscard]] auto zoom() const noexcept -> value_type;
+
+		auto set_zoom(value_type zoom) noexcept -> void;
+
+		[[nodiscard]] auto world_to_screen() const noexcept -> const Transform2D&;
+
+		[[nodiscard]] auto screen_to_world() const noexcept -> const Transform2D&;
+
+		// world space
+		[[nodiscard]] auto view() const noexcept -> const math::AABB&;
+
+		[[nodiscard]] auto to_screen(const glm::vec2& world) const noexcept -> glm::vec2;
+
+		[[nodiscard]] auto to_world(const glm::vec2& screen) const noexcept -> glm::vec2;
+
+		// `bounds` (world space) overlaps the view
+		[[nodiscard]] auto visible(const math::AABB& bounds) const noexcept -> bool;
+
+		// the circle (world space) overlaps the view (conservatively, its bounding square is tested)
+		[[nodiscard]] auto visible(const glm::vec2& center, value_type radius) const noexcept -> bool;
+	};
+}
@@ -0,0 +1,241 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <variant>
+#include <vector>
+
+#include <pb/math/angle.hpp>
+#include <pb/render/camera.hpp>
+
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+
+namespace pb::core::render
+{
+	enum class BlendMode : std::uint8_t
+	{
+		NONE,
+		BLEND,
+		BLEND_PREMULTIPLIED,
+		ADD,
+		MOD,
+		MUL,
+	};
+
+	/**
+	 * @brief Where a command is drawn relative to the others.
+	 *
+	 * (layer, depth) is the painter's order, commands with the same (layer, depth) are assumed not to overlap
+	 * and are grouped by blend mode then texture so that they can be submitted together.
+	 */
+	struct DrawOrder
+	{
+		std::uint8_t layer;
+		std::uint16_t depth;
+		BlendMode blend;
+	};
+
+	namespace command_queue_detail
+	{
+		using key_type = std::uint64_t;
+
+		// layer (8) | depth (16) | blend (8) | texture (32)
+		[[nodiscard]] constexpr auto make_key(const DrawOrder& order, const std::uint32_t texture) noexcept -> key_type
+		{
+			return
+					static_cast<key_type>(order.layer) << 56 |
+					static_cast<key_type>(order.depth) << 40 |
+					static_cast<key_type>(order.blend) << 32 |
+					static_cast<key_type>(texture);
+		}
+
+		struct sprite_type
+		{
+			// in pixels, `has_source` is false for the whole texture
+			SDL_FRect source;
+			SDL_FRect destination;
+			// around the center of `destination`
+			math::Angle rotation;
+			SDL_FColor color;
+			bool has_source;
+		};
+
+		struct geometry_type
+		{
+			// in `CommandBuffer::vertices_`
+			std::uint32_t vertex_offset;
+			std::uint32_t vertex_count;
+			// in `CommandBuffer::indices_`, 0 if the vertices are a list of triangles
+			std::uint32_t index_offset;
+			std::uint32_t index_count;
+		};
+
+		struct text_type
+		{
+			TTF_Text* text;
+			float x;
+			float y;
+		};
+
+		using data_type = std::variant<sprite_type, geometry_type, text_type>;
+
+		struct command_type
+		{
+			data_type data;
+			SDL_Texture* texture;
+			BlendMode blend;
+			// 1 + index in `CommandBuffer::clips_`, 0 if not clipped
+			std::uint32_t clip;
+		};
+	}
+
+	/**
+	 * @brief Draw commands recorded by one thread, see `CommandQueue::acquire`.
+	 *
+	 * Recording does not call SDL, a buffer can be filled on any thread as long as only one thread uses it at a time.
+	 */
+	class CommandBuffer
+	{
+		friend class CommandQueue;
+
+	public:
+		using size_type = std::size_t;
+
+	private:
+		std::vector<command_queue_detail::key_type> keys_;
+		std::vector<command_queue_detail::command_type> commands_;
+
+		std::vector<SDL_Vertex> vertices_;
+		std::vector<int> indices_;
+
+		std::vector<SDL_Rect> clips_;
+		std::uint32_t clip_;
+
+		auto push(const DrawOrder& order, SDL_Texture* texture, std::uint32_t texture_key, command_queue_detail::data_type&& data) -> void;
+
+		auto clear() noexcept -> void;
+
+	public:
+		CommandBuffer() noexcept;
+
+		[[nodiscard]] auto size() const noexcept -> size_type;
+
+		// the following commands are clipped to `rect` (render coordinates)
+		auto set_clip(const SDL_Rect& rect) -> void;
+
+		// the following commands are not clipped (beyond the clip rect of the renderer at `CommandQueue::execute`)
+		auto reset_clip() noexcept -> void;
+
+		/**
+		 * @brief Draw `source` (in pixels, nullptr for the whole texture) of `texture` into `destination`, rotated around its center.
+		 *
+		 * Sprites of the same texture (and blend mode, clip) are merged into one `SDL_RenderGeometry`.
+		 */
+		auto sprite(
+			const DrawOrder& order,
+			SDL_Texture* texture,
+			const SDL_FRect& destination,
+			const SDL_FRect* source = nullptr,
+			math::Angle rotation = math::Angle::zero(),
+			const SDL_FColor& color = {.r = 1, .g = 1, .b = 1, .a = 1}
+		) -> void;
+
+		/**
+		 * @brief Draw a sprite whose `destination` is in world space through `camera`.
+		 *
+		 * Nothing is recorded if the sprite is outside of the view of `camera`.
+		 * @return false if the sprite was culled.
+		 */
+		auto sprite(
+			const DrawOrder& order,
+			SDL_Texture* texture,
+			const Camera2D& camera,
+			const SDL_FRect& destination,
+			const SDL_FRect* source = nullptr,
+			math::Angle rotation = math::Angle::zero(),
+			const SDL_FColor& color = {.r = 1, .g = 1, .b = 1, .a = 1}
+		) -> bool;
+
+		// `vertices` and `indices` are copied, an empty `indices` draws `vertices` as a list of triangles
+		auto geometry(const DrawOrder& order, SDL_Texture* texture, std::span<const SDL_Vertex> vertices, std::span<const int> indices = {}) -> void;
+
+		// `text` must stay alive until the queue is executed
+		auto text(const DrawOrder& order, TTF_Text* text, float x, float y) -> void;
+	};
+
+	/**
+	 * @brief Draw commands recorded in parallel and submitted in order on the main thread.
+	 *
+	 * Every task records into its own buffer, `execute` merges the buffers, sorts the commands by their key
+	 * (layer, depth, blend mode, texture) and submits them to the renderer, merging consecutive sprites/geometries
+	 * that share a texture, a blend mode and a clip into a single `SDL_RenderGeometry`.
+	 * Commands with the same key keep the order of the buffers (in `acquire` order) then the order in which they were recorded.
+	 *
+	 * @code
+	 * CommandQueue queue;
+	 *
+	 * // worker threads
+	 * auto& buffer = queue.acquire();
+	 * for (const auto& entity: chunk) { buffer.sprite({.layer = 1, .depth = entity.depth, .blend = BlendMode::BLEND}, entity.texture, entity.rect); }
+	 *
+	 * // main thread, once every task finished
+	 * queue.execute(renderer);
+	 * @endcode
+	 *
+	 * @note The blend mode of the drawn textures is overwritten.
+	 * The draw blend mode and the clip rect of the renderer are restored after `execute`,
+	 * commands recorded without a clip use the clip rect the renderer had when `execute` was called.
+	 */
+	class CommandQueue
+	{
+	public:
+		using size_type = std::size_t;
+
+	private:
+		struct entry_type
+		{
+			command_queue_detail::key_type key;
+			std::uint32_t buffer;
+			std::uint32_t command;
+		};
+
+		std::mutex mutex_;
+		// buffers are kept (with their capacity) between frames
+		std::vector<std::unique_ptr<CommandBuffer>> buffers_;
+		size_type acquired_;
+
+		std::vector<entry_type> entries_;
+		std::vector<entry_type> scratch_;
+
+		// the batch being merged
+		std::vector<SDL_Vertex> vertices_;
+		std::vector<int> indices_;
+
+	public:
+		CommandQueue() noexcept;
+
+		/**
+		 * @brief An empty buffer for the calling task, thread-safe.
+		 *
+		 * The buffer belongs to the caller until `execute`, a task may acquire more than one buffer.
+		 */
+		[[nodiscard]] auto acquire() -> CommandBuffer&;
+
+		/**
+		 * @brief Sort and submit every recorded command, then clear the buffers.
+		 *
+		 * Must be called on the thread of `renderer`, after every task recording into the buffers finished.
+		 * @return the number of draw calls.
+		 */
+		auto execute(SDL_Renderer* renderer) -> size_type;
+	};
+}
@@ -0,0 +1,176 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <pb/graphics/color.hpp>
+#include <pb/math/angle.hpp>
+#include <pb/math/position.hpp>
+#include <pb/render/camera.hpp>
+
+#include <glm/vec2.hpp>
+
+#include <SDL3/SDL.h>
+
+namespace pb::core::render
+{
+	// the initial state of an emitted particle
+	struct Particle
+	{
+		math::Position position;
+		// units per second
+		glm::vec2 velocity;
+		// seconds
+		float lifetime;
+		// width and height of the quad
+		float size;
+		math::Angle rotation;
+		// degrees per second
+		math::Angle spin;
+		// the alpha fades linearly to 0 over the lifetime
+		infra::graphics::Color color;
+	};
+
+	/**
+	 * @brief Particles stored as arrays of attributes (position, velocity, lifetime, rotation, color...) and drawn as textured quads.
+	 *
+	 * `update` integrates the particles and writes their quads straight into the vertex array submitted by `render`,
+	 * 4 particles at a time with SSE2. The quads are drawn with the whole texture.
+	 * With a camera (`set_camera`), the particles outside of its view are still simulated but get no quad,
+	 * and the quads are written in screen space.
+	 *
+	 * @code
+	 * ParticleSystem sparks{100'000};
+	 * sparks.set_acceleration({0, 98});
+	 * sparks.set_camera(&camera);
+	 *
+	 * sparks.emit({.position = {x, y}, .velocity = {0, -200}, .lifetime = 1.5f, .size = 8, .rotation = Angle::zero(), .spin = Angle::from_degrees(90), .color = 0xffcc00ff_rgba});
+	 *
+	 * // every frame
+	 * sparks.update(delta_time, [&](std::size_t count, const auto& job) { parallel_for(count, job); });
+	 * sparks.render(renderer, spark_texture);
+	 * @endcode
+	 */
+	class ParticleSystem
+	{
+	public:
+		using size_type = std::size_t;
+
+		// particles per job of `update`
+		constexpr static size_type chunk_size = 1024;
+
+	private:
+		size_type capacity_;
+		size_type size_;
+
+		glm::vec2 acceleration_;
+
+		std::vector<float> x_;
+		std::vector<float> y_;
+		std::vector<float> velocity_x_;
+		std::vector<float> velocity_y_;
+		// seconds left, the particle is removed on the next `update` once it reaches 0
+		std::vector<float> remaining_;
+		std::vector<float> inverse_lifetime_;
+		std::vector<float> size_of_;
+		std::vector<math::Angle> rotation_;
+		std::vector<float> spin_;
+		std::vector<infra::graphics::Color> color_;
+
+		// nullptr to draw in world space without culling
+		const Camera2D* camera_;
+
+		// 4 per drawn particle, the texture coordinates never change
+		std::vector<SDL_Vertex> vertices_;
+		// 6 per drawn particle, never change
+		std::vector<int> indices_;
+
+		// quads written by each chunk of the last `update`, at the beginning of the chunk
+		std::vector<size_type> chunk_quads_;
+		// quads at the beginning of `vertices_` once the chunks are packed
+		size_type quads_;
+
+		// swap-remove the particles whose lifetime ended
+		auto compact() noexcept -> void;
+
+		// integrate the particles [begin, end) and write the quads of the alive and visible ones from `begin`
+		// @return the number of written quads
+		[[nodiscard]] auto simulate(float delta, size_type begin, size_type end) noexcept -> size_type;
+
+		// move the quads of every chunk right after the ones of the previous chunk
+		auto pack() noexcept -> void;
+
+	public:
+		explicit ParticleSystem(size_type capacity);
+
+		[[nodiscard]] auto capacity() const noexcept -> size_type;
+
+		[[nodiscard]] auto size() const noexcept -> size_type;
+
+		[[nodiscard]] auto empty() const noexcept -> bool;
+
+		// units per second^2, applied to every particle
+		[[nodiscard]] auto acceleration() const noexcept -> const glm::vec2&;
+
+		auto set_acceleration(const glm::vec2& acceleration) noexcept -> void;
+
+		[[nodiscard]] auto camera() const noexcept -> const Camera2D*;
+
+		// the following `update`s cull against the view of `camera` (nullptr to disable), `camera` must outlive the system (or be reset)
+		auto set_camera(const Camera2D* camera) noexcept -> void;
+
+		// false if the system is full
+		auto emit(const Particle& particle) noexcept -> bool;
+
+		auto clear() noexcept -> void;
+
+		// the particles drawn by `render`, written by the last `update`
+		[[nodiscard]] auto drawn() const noexcept -> size_type;
+
+		// world space (screen space with a camera), valid after `update`
+		[[nodiscard]] auto vertices() const noexcept -> std::span<const SDL_Vertex>;
+
+		[[nodiscard]] auto indices() const noexcept -> std::span<const int>;
+
+		// advance every particle by `delta` seconds on the calling thread
+		auto update(float delta) noexcept -> void;
+
+		/**
+		 * @brief Advance every particle by `delta` seconds, in chunks of `chunk_size` particles.
+		 *
+		 * `dispatch(chunk_count, job)` must invoke `job(chunk_index)` exactly once for every chunk index in [0, chunk_count),
+		 * in any order and on any thread, and return once all jobs are done.
+		 */
+		template<typename Dispatch>
+		auto update(const float delta, Dispatch&& dispatch) -> void
+		{
+			compact();
+
+			const auto chunk_count = (size_ + chunk_size - 1) / chunk_size;
+			chunk_quads_.resize(chunk_count);
+
+			const auto job = [this, delta](const std::size_t chunk) noexcept -> void
+			{
+				const auto begin = chunk * chunk_size;
+				const auto end = begin + chunk_size < size_ ? begin + chunk_size : size_;
+
+				chunk_quads_[chunk] = simulate(delta, begin, end);
+			};
+
+			std::forward<Dispatch>(dispatch)(chunk_count, job);
+
+			pack();
+		}
+
+		// draw the particles written by the last `update` with `texture` (nullptr for plain colored quads), the blend mode is the one of `texture`
+		auto render(SDL_Renderer* renderer, SDL_Texture* texture) const -> void;
+	};
+}
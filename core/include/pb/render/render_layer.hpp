@@ -0,0 +1,107 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include <SDL3/SDL.h>
+
+namespace pb::core::render
+{
+	namespace render_layer_detail
+	{
+		struct texture_deleter
+		{
+			auto operator()(SDL_Texture* texture) const noexcept -> void
+			{
+				SDL_DestroyTexture(texture);
+			}
+		};
+	}
+
+	/**
+	 * @brief A static layer (background, HUD frame...) drawn once into a target texture and then blitted with one call per frame.
+	 *
+	 * The layer is drawn again only after `mark_dirty` (its content changed) or when the render targets were lost
+	 * (call `mark_dirty` on `SDL_EVENT_RENDER_TARGETS_RESET` / `SDL_EVENT_RENDER_DEVICE_RESET`).
+	 * If the renderer does not support target textures, the layer is drawn directly every frame.
+	 *
+	 * @code
+	 * RenderLayer hud{1920, 1080};
+	 *
+	 * // every frame
+	 * hud.render(renderer, [&](SDL_Renderer* r) { draw_hud_frame(r); });
+	 * @endcode
+	 */
+	class RenderLayer
+	{
+	public:
+		using size_type = int;
+
+	private:
+		std::unique_ptr<SDL_Texture, render_layer_detail::texture_deleter> texture_;
+		size_type width_;
+		size_type height_;
+		bool dirty_;
+		// the target texture cannot be created, draw directly
+		bool direct_;
+
+		// previous render target and draw color, restored by `end`
+		SDL_Texture* previous_target_;
+		SDL_Color previous_color_;
+
+		[[nodiscard]] auto prepare(SDL_Renderer* renderer) -> bool;
+
+		auto begin(SDL_Renderer* renderer) -> void;
+
+		auto end(SDL_Renderer* renderer) -> void;
+
+		auto present(SDL_Renderer* renderer, const SDL_FRect* destination) const -> void;
+
+	public:
+		// `width` x `height` pixels, usually the logical size of the renderer so the layer is drawn with the same coordinates
+		RenderLayer(size_type width, size_type height) noexcept;
+
+		[[nodiscard]] auto width() const noexcept -> size_type;
+
+		[[nodiscard]] auto height() const noexcept -> size_type;
+
+		[[nodiscard]] auto dirty() const noexcept -> bool;
+
+		// draw the layer again on the next `render`
+		auto mark_dirty() noexcept -> void;
+
+		// recreate the texture (and draw again) with another size
+		auto resize(size_type width, size_type height) noexcept -> void;
+
+		/**
+		 * @brief Blit the layer to the current render target, `draw(renderer)` is called first if the layer is dirty.
+		 * @param destination where the layer is blitted, nullptr for the whole target.
+		 * @return true if `draw` was called.
+		 */
+		template<typename Draw>
+		auto render(SDL_Renderer* renderer, Draw&& draw, const SDL_FRect* destination = nullptr) -> bool
+		{
+			if (not prepare(renderer))
+			{
+				std::forward<Draw>(draw)(renderer);
+				return true;
+			}
+
+			const auto redraw = dirty_;
+			if (redraw)
+			{
+				begin(renderer);
+				std::forward<Draw>(draw)(renderer);
+				end(renderer);
+			}
+
+			present(renderer, destination);
+			return redraw;
+		}
+	};
+}
@@ -0,0 +1,114 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <pb/math/aabb.hpp>
+#include <pb/render/camera.hpp>
+#include <pb/render/transform.hpp>
+
+#include <glm/vec2.hpp>
+
+#include <SDL3/SDL.h>
+
+namespace pb::core::render
+{
+	/**
+	 * @brief A texture cut into a grid of tiles, tile index `i` is at column `i % columns`, row `i / columns`.
+	 */
+	struct TileSet
+	{
+		SDL_Texture* texture;
+		// in pixels
+		glm::vec2 texture_size;
+		// in pixels
+		glm::vec2 tile_size;
+		std::uint32_t columns;
+	};
+
+	/**
+	 * @brief Tile grid drawn with `SDL_RenderGeometry`, one call per visible chunk of `chunk_size` x `chunk_size` tiles.
+	 *
+	 * The vertices and indices of a chunk are built once and kept until one of its tiles changes,
+	 * drawing costs in proportion to the visible chunks, not to the size of the map.
+	 */
+	class Tilemap
+	{
+	public:
+		using size_type = std::uint32_t;
+		// 0 is empty, otherwise `tile - 1` is the index in the tile set
+		using tile_type = std::uint16_t;
+
+		constexpr static tile_type empty_tile = 0;
+		constexpr static size_type chunk_size = 32;
+
+	private:
+		struct chunk_type
+		{
+			// world space, 4 per non-empty tile
+			std::vector<SDL_Vertex> vertices;
+			// 6 per non-empty tile
+			std::vector<int> indices;
+			bool dirty;
+		};
+
+		size_type width_;
+		size_type height_;
+		size_type chunk_columns_;
+		size_type chunk_rows_;
+
+		TileSet tile_set_;
+		// world position of the top-left corner of tile (0, 0)
+		glm::vec2 origin_;
+		// world size of a tile
+		glm::vec2 tile_size_;
+
+		// row-major
+		std::vector<tile_type> tiles_;
+		// row-major
+		std::vector<chunk_type> chunks_;
+
+		// positions transformed for the current draw
+		std::vector<SDL_Vertex> transformed_;
+
+		auto build(size_type chunk_x, size_type chunk_y) -> void;
+
+	public:
+		Tilemap(size_type width, size_type height, const TileSet& tile_set, const glm::vec2& tile_size, const glm::vec2& origin = {0, 0});
+
+		[[nodiscard]] auto width() const noexcept -> size_type;
+
+		[[nodiscard]] auto height() const noexcept -> size_type;
+
+		[[nodiscard]] auto bounds() const noexcept -> math::AABB;
+
+		[[nodiscard]] auto tile(size_type x, size_type y) const noexcept -> tile_type;
+
+		// rebuilds the chunk of (x, y) on its next draw
+		auto set_tile(size_type x, size_type y, tile_type tile) noexcept -> void;
+
+		// `tiles` is row-major, `width` x `height`
+		auto set_tiles(const std::vector<tile_type>& tiles) -> void;
+
+		// the tile set texture changed (e.g. reloaded), every chunk is rebuilt
+		auto set_tile_set(const TileSet& tile_set) noexcept -> void;
+
+		/**
+		 * @brief Draw the chunks overlapping `view` (world space).
+		 *
+		 * `world_to_screen` maps world positions to render coordinates, the cached vertices are submitted as is when it is the identity,
+		 * otherwise only their positions are transformed.
+		 * @return the number of drawn chunks.
+		 */
+		auto render(SDL_Renderer* renderer, const math::AABB& view, const Transform2D& world_to_screen = {}) -> size_type;
+
+		// draw the chunks overlapping the view of `camera`
+		auto render(SDL_Renderer* renderer, const Camera2D& camera) -> size_type;
+	};
+}
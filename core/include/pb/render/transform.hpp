@@ -0,0 +1,81 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <glm/vec2.hpp>
+
+namespace pb::core::render
+{
+	/**
+	 * @brief 2D affine transform, `point` => x_axis * point.x + y_axis * point.y + translation.
+	 */
+	class Transform2D
+	{
+	public:
+		using value_type = float;
+
+	private:
+		glm::vec2 x_axis_;
+		glm::vec2 y_axis_;
+		glm::vec2 translation_;
+
+	public:
+		constexpr Transform2D(const glm::vec2& x_axis, const glm::vec2& y_axis, const glm::vec2& translation) noexcept
+			: x_axis_{x_axis},
+			  y_axis_{y_axis},
+			  translation_{translation} {}
+
+		constexpr Transform2D() noexcept
+			: Transform2D{{1, 0}, {0, 1}, {0, 0}} {}
+
+		[[nodiscard]] constexpr static auto identity() noexcept -> Transform2D
+		{
+			return {};
+		}
+
+		[[nodiscard]] constexpr static auto translate(const glm::vec2& translation) noexcept -> Transform2D
+		{
+			return {{1, 0}, {0, 1}, translation};
+		}
+
+		[[nodiscard]] constexpr auto x_axis() const noexcept -> const glm::vec2&
+		{
+			return x_axis_;
+		}
+
+		[[nodiscard]] constexpr auto y_axis() const noexcept -> const glm::vec2&
+		{
+			return y_axis_;
+		}
+
+		[[nodiscard]] constexpr auto translation() const noexcept -> const glm::vec2&
+		{
+			return translation_;
+		}
+
+		[[nodiscard]] constexpr auto is_identity() const noexcept -> bool
+		{
+			return x_axis_ == glm::vec2{1, 0} and y_axis_ == glm::vec2{0, 1} and translation_ == glm::vec2{0, 0};
+		}
+
+		[[nodiscard]] constexpr auto apply(const glm::vec2& point) const noexcept -> glm::vec2
+		{
+			return x_axis_ * point.x + y_axis_ * point.y + translation_;
+		}
+
+		// apply `other` first, then this
+		[[nodiscard]] constexpr auto operator*(const Transform2D& other) const noexcept -> Transform2D
+		{
+			return {
+					x_axis_ * other.x_axis_.x + y_axis_ * other.x_axis_.y,
+					x_axis_ * other.y_axis_.x + y_axis_ * other.y_axis_.y,
+					apply(other.translation_)
+			};
+		}
+
+		[[nodiscard]] constexpr auto operator==(const Transform2D& other) const noexcept -> bool = default;
+	};
+}
@@ -0,0 +1,606 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <pb/asset/asset_manager.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <exception>
+#include <ranges>
+#include <string>
+
+#include <pb/macro.hpp>
+#include <pb/platform/os.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <SDL3_image/SDL_image.h>
+
+namespace
+{
+	using namespace pb::core::asset;
+
+	struct surface_deleter
+	{
+		auto operator()(SDL_Surface* surface) const noexcept -> void
+		{
+			SDL_DestroySurface(surface);
+		}
+	};
+
+	using surface_type = std::unique_ptr<SDL_Surface, surface_deleter>;
+
+	// thumbnails and images of the same file have different keys
+	constexpr std::uint64_t thumbnail_seed = std::uint64_t{0x5448'554d} << 32;
+
+	// halve with bilinear filtering first, a single large linear step skips most source pixels
+	[[nodiscard]] auto downscale(surface_type surface, const std::uint32_t size) -> surface_type
+	{
+		const auto fit = [size](const int width, const int height) noexcept -> bool
+		{
+			return static_cast<std::uint32_t>(width) <= size and static_cast<std::uint32_t>(height) <= size;
+		};
+
+		while (surface != nullptr and not fit(surface->w, surface->h))
+		{
+			auto width = surface->w;
+			auto height = surface->h;
+
+			if (fit(width / 2, height / 2))
+			{
+				const auto scale = static_cast<float>(size) / static_cast<float>(std::ranges::max(width, height));
+				width = static_cast<int>(static_cast<float>(width) * scale);
+				height = static_cast<int>(static_cast<float>(height) * scale);
+			}
+			else
+			{
+				width /= 2;
+				height /= 2;
+			}
+
+			surface.reset(SDL_ScaleSurface(surface.get(), std::ranges::max(width, 1), std::ranges::max(height, 1), SDL_SCALEMODE_LINEAR));
+		}
+
+		return surface;
+	}
+
+	// SDL expects UTF-8 paths on every platform
+	[[nodiscard]] auto utf8_of(const std::filesystem::path& path) -> std::string
+	{
+		const auto string = path.generic_u8string();
+		return {reinterpret_cast<const char*>(string.data()), string.size()};
+	}
+}
+
+namespace pb::core::asset
+{
+	auto AssetManager::locate(const std::filesystem::path& path, file_type& file) const -> bool
+	{
+		std::shared_lock lock{packs_mutex_};
+
+		if (packs_.empty())
+		{
+			return false;
+		}
+
+		const auto name = infra::utility::Pack::normalize(path);
+		for (const auto& pack: packs_ | std::views::reverse)
+		{
+			if (const auto entry = pack.find(std::string_view{name});
+				entry.has_value())
+			{
+				if (entry->compression != infra::utility::PackCompression::NONE)
+				{
+					SPDLOG_WARN("[ASSET] {} 在资源包中被压缩, 尚不支持解压", name);
+					continue;
+				}
+
+				file.bytes = entry->data;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	auto AssetManager::open(const std::filesystem::path& path, const bool bypass_packs) const -> SDL_IOStream*
+	{
+		if (file_type file; not bypass_packs and locate(path, file))
+		{
+			return SDL_IOFromConstMem(file.bytes.data(), file.bytes.size());
+		}
+
+		return SDL_IOFromFile(utf8_of(path).c_str(), "rb");
+	}
+
+	auto AssetManager::read(const std::filesystem::path& path, const bool bypass_packs) const -> std::optional<file_type>
+	{
+		if (file_type file; not bypass_packs and locate(path, file))
+		{
+			return file;
+		}
+
+		auto* stream = SDL_IOFromFile(utf8_of(path).c_str(), "rb");
+		if (stream == nullptr)
+		{
+			return std::nullopt;
+		}
+
+		std::optional<file_type> result;
+		if (const auto size = SDL_GetIOSize(stream);
+			size >= 0)
+		{
+			result.emplace();
+			result->storage.resize(static_cast<std::size_t>(size));
+			if (SDL_ReadIO(stream, result->storage.data(), result->storage.size()) != result->storage.size())
+			{
+				result.reset();
+			}
+			else
+			{
+				result->bytes = result->storage;
+			}
+		}
+
+		SDL_CloseIO(stream);
+		return result;
+	}
+
+	auto AssetManager::work(const std::stop_token stop_token) noexcept -> void
+	{
+		while (true)
+		{
+			std::move_only_function<auto() -> void> job;
+			{
+				std::unique_lock lock{decode_mutex_};
+				if (not decode_condition_.wait(lock, stop_token, [this]() noexcept -> bool { return not decode_queue_.empty(); }))
+				{
+					return;
+				}
+
+				job = std::move(decode_queue_.front());
+				decode_queue_.pop_front();
+			}
+
+			job();
+		}
+	}
+
+	auto AssetManager::decode(std::move_only_function<auto() -> void> job) -> void
+	{
+		{
+			std::scoped_lock lock{decode_mutex_};
+			decode_queue_.emplace_back(std::move(job));
+		}
+
+		decode_condition_.notify_one();
+	}
+
+	auto AssetManager::upload(const size_type bytes, std::move_only_function<auto(SDL_Renderer*) -> void> commit) -> void
+	{
+		std::scoped_lock lock{upload_mutex_};
+		upload_queue_.emplace_back(bytes, std::move(commit));
+	}
+
+	auto AssetManager::fail(std::atomic<AssetState>& state, const std::filesystem::path& path, const char* reason) noexcept -> void
+	{
+		SPDLOG_ERROR("[ASSET] 载入 {} 失败! {}", path.generic_string(), reason);
+
+		// a reloaded asset keeps its previous value (READY) or failure (FAILED)
+		auto expected = AssetState::LOADING;
+		state.compare_exchange_strong(expected, AssetState::FAILED, std::memory_order_release, std::memory_order_relaxed);
+		pending_.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	auto AssetManager::default_worker_count() noexcept -> size_type
+	{
+		// leave one core to the main thread
+		const auto concurrency = static_cast<size_type>(std::thread::hardware_concurrency());
+		return concurrency > 2 ? concurrency - 1 : 1;
+	}
+
+	auto AssetManager::hash_of(const std::filesystem::path& path, const infra::meta::hash_type seed) noexcept -> infra::meta::hash_type
+	{
+		const auto hash = infra::meta::fnv1a(path.lexically_normal().generic_string());
+		return seed == 0 ? hash : infra::meta::fnv1a_append(hash, seed);
+	}
+
+	AssetManager::AssetManager(SDL_Renderer* renderer, const size_type worker_count)
+		: renderer_{renderer},
+		  pending_{0}
+	{
+		const auto count = std::ranges::max(worker_count, size_type{1});
+
+		workers_.reserve(count);
+		for (size_type i = 0; i < count; ++i)
+		{
+			workers_.emplace_back([this](const std::stop_token stop_token) noexcept -> void { work(stop_token); });
+		}
+	}
+
+	AssetManager::~AssetManager() noexcept
+	{
+		// stop all workers before joining any of them, the queued jobs are dropped
+		for (auto& worker: workers_)
+		{
+			worker.request_stop();
+		}
+		workers_.clear();
+	}
+
+	auto AssetManager::mount(infra::utility::Pack pack) -> void
+	{
+		SPDLOG_INFO("[ASSET] 挂载资源包, 共 {} 个文件", pack.size());
+
+		std::unique_lock lock{packs_mutex_};
+		packs_.emplace_back(std::move(pack));
+	}
+
+	auto AssetManager::decode_texture(std::shared_ptr<asset_manager_detail::Slot<Texture>> slot, const bool bypass_packs) -> void
+	{
+		pending_.fetch_add(1, std::memory_order_relaxed);
+
+		decode(
+			[this, slot = std::move(slot), bypass_packs]() -> void
+			{
+				surface_type surface{IMG_Load_IO(open(slot->path, bypass_packs), true)};
+				if (surface == nullptr)
+				{
+					fail(slot->state, slot->path, SDL_GetError());
+					return;
+				}
+
+				if (const auto size = slot->value.thumbnail;
+					size != 0)
+				{
+					surface = downscale(std::move(surface), size);
+					if (surface == nullptr)
+					{
+						fail(slot->state, slot->path, SDL_GetError());
+						return;
+					}
+				}
+
+				// same layout as `graphics::Color`, the renderer does not have to convert it on the main thread
+				if (surface->format != SDL_PIXELFORMAT_RGBA32)
+				{
+					surface.reset(SDL_ConvertSurface(surface.get(), SDL_PIXELFORMAT_RGBA32));
+					if (surface == nullptr)
+					{
+						fail(slot->state, slot->path, SDL_GetError());
+						return;
+					}
+				}
+
+				const auto bytes = static_cast<size_type>(surface->h) * static_cast<size_type>(surface->pitch);
+				upload(
+					bytes,
+					[this, slot, surface = std::move(surface)](SDL_Renderer* renderer) -> void
+					{
+						auto* texture = SDL_CreateTextureFromSurface(renderer, surface.get());
+						if (texture == nullptr)
+						{
+							fail(slot->state, slot->path, SDL_GetError());
+							return;
+						}
+
+						// the previous texture (if reloaded) is destroyed here, between two frames
+						slot->value.texture.reset(texture);
+						slot->value.width = static_cast<float>(surface->w);
+						slot->value.height = static_cast<float>(surface->h);
+						slot->version += 1;
+
+						slot->state.store(AssetState::READY, std::memory_order_release);
+						pending_.fetch_sub(1, std::memory_order_relaxed);
+					}
+				);
+			}
+		);
+	}
+
+	auto AssetManager::decode_font(std::shared_ptr<asset_manager_detail::Slot<Font>> slot, const bool bypass_packs) -> void
+	{
+		pending_.fetch_add(1, std::memory_order_relaxed);
+
+		decode(
+			[this, slot = std::move(slot), bypass_packs]() -> void
+			{
+				auto file = read(slot->path, bypass_packs);
+				if (not file.has_value())
+				{
+					fail(slot->state, slot->path, SDL_GetError());
+					return;
+				}
+
+				const auto bytes = file->bytes.size();
+				upload(
+					bytes,
+					[this, slot, file = std::move(*file)](SDL_Renderer*) mutable -> void
+					{
+						// SDL3_ttf shares one FreeType library, fonts are opened on the main thread only
+						auto* font = TTF_OpenFontIO(SDL_IOFromConstMem(file.bytes.data(), file.bytes.size()), true, slot->value.size);
+						if (font == nullptr)
+						{
+							fail(slot->state, slot->path, SDL_GetError());
+							return;
+						}
+
+						// close the previous font (if reloaded) before releasing its buffer,
+						// moving the vector keeps its buffer, `bytes` stays valid
+						slot->value.font.reset(font);
+						slot->value.data = std::move(file.storage);
+						slot->version += 1;
+
+						slot->state.store(AssetState::READY, std::memory_order_release);
+						pending_.fetch_sub(1, std::memory_order_relaxed);
+					}
+				);
+			}
+		);
+	}
+
+	auto AssetManager::decode_json(std::shared_ptr<asset_manager_detail::Slot<Json>> slot, const bool bypass_packs) -> void
+	{
+		pending_.fetch_add(1, std::memory_order_relaxed);
+
+		decode(
+			[this, slot = std::move(slot), bypass_packs]() -> void
+			{
+				const auto file = read(slot->path, bypass_packs);
+				if (not file.has_value())
+				{
+					fail(slot->state, slot->path, SDL_GetError());
+					return;
+				}
+
+				const auto* begin = reinterpret_cast<const char*>(file->bytes.data());
+				auto value = nlohmann::json::parse(begin, begin + file->bytes.size(), nullptr, false);
+				if (value.is_discarded())
+				{
+					fail(slot->state, slot->path, "JSON 格式错误");
+					return;
+				}
+
+				// nothing to upload, the value is published on the main thread like every other asset
+				upload(
+					0,
+					[this, slot, value = std::move(value)](SDL_Renderer*) mutable -> void
+					{
+						slot->value.value = std::move(value);
+						slot->version += 1;
+
+						slot->state.store(AssetState::READY, std::memory_order_release);
+						pending_.fetch_sub(1, std::memory_order_relaxed);
+					}
+				);
+			}
+		);
+	}
+
+	auto AssetManager::load_texture(const std::filesystem::path& path) -> Handle<Texture>
+	{
+		const auto hash = hash_of(path);
+
+		if (const auto it = textures_.find(hash);
+			it != textures_.end())
+		{
+			return Handle<Texture>{it->second};
+		}
+
+		auto slot = std::make_shared<asset_manager_detail::Slot<Texture>>();
+		slot->hash = hash;
+		slot->path = path;
+		slot->state.store(AssetState::LOADING, std::memory_order_relaxed);
+		textures_.emplace(hash, slot);
+
+		if (watcher_.has_value())
+		{
+			watcher_->watch(path);
+		}
+
+		decode_texture(slot);
+		return Handle<Texture>{std::move(slot)};
+	}
+
+	auto AssetManager::load_thumbnail(const std::filesystem::path& path, const std::uint32_t size) -> Handle<Texture>
+	{
+		PB_ERROR_DEBUG_ASSUME(size != 0);
+
+		const auto hash = hash_of(path, thumbnail_seed | size);
+
+		if (const auto it = textures_.find(hash);
+			it != textures_.end())
+		{
+			return Handle<Texture>{it->second};
+		}
+
+		auto slot = std::make_shared<asset_manager_detail::Slot<Texture>>();
+		slot->hash = hash;
+		slot->path = path;
+		slot->state.store(AssetState::LOADING, std::memory_order_relaxed);
+		// read by the decoder, never changes
+		slot->value.thumbnail = size;
+		textures_.emplace(hash, slot);
+
+		if (watcher_.has_value())
+		{
+			watcher_->watch(path);
+		}
+
+		decode_texture(slot);
+		return Handle<Texture>{std::move(slot)};
+	}
+
+	auto AssetManager::load_font(const std::filesystem::path& path, const float size) -> Handle<Font>
+	{
+		const auto hash = hash_of(path, std::bit_cast<std::uint32_t>(size));
+
+		if (const auto it = fonts_.find(hash);
+			it != fonts_.end())
+		{
+			return Handle<Font>{it->second};
+		}
+
+		auto slot = std::make_shared<asset_manager_detail::Slot<Font>>();
+		slot->hash = hash;
+		slot->path = path;
+		slot->state.store(AssetState::LOADING, std::memory_order_relaxed);
+		slot->value.size = size;
+		fonts_.emplace(hash, slot);
+
+		if (watcher_.has_value())
+		{
+			watcher_->watch(path);
+		}
+
+		decode_font(slot);
+		return Handle<Font>{std::move(slot)};
+	}
+
+	auto AssetManager::load_json(const std::filesystem::path& path) -> Handle<Json>
+	{
+		const auto hash = hash_of(path);
+
+		if (const auto it = jsons_.find(hash);
+			it != jsons_.end())
+		{
+			return Handle<Json>{it->second};
+		}
+
+		auto slot = std::make_shared<asset_manager_detail::Slot<Json>>();
+		slot->hash = hash;
+		slot->path = path;
+		slot->state.store(AssetState::LOADING, std::memory_order_relaxed);
+		jsons_.emplace(hash, slot);
+
+		if (watcher_.has_value())
+		{
+			watcher_->watch(path);
+		}
+
+		decode_json(slot);
+		return Handle<Json>{std::move(slot)};
+	}
+
+	auto AssetManager::enable_hot_reload() -> void
+	{
+		if (watcher_.has_value())
+		{
+			return;
+		}
+
+		watcher_.emplace();
+
+		const auto watch = [this](const auto& map) -> void
+		{
+			for (const auto& slot: map | std::views::values)
+			{
+				watcher_->watch(slot->path);
+			}
+		};
+
+		watch(textures_);
+		watch(fonts_);
+		watch(jsons_);
+
+		SPDLOG_INFO("[ASSET] 已启用热重载");
+	}
+
+	auto AssetManager::reload(const std::filesystem::path& path) -> size_type
+	{
+		const auto name = path.lexically_normal().generic_string();
+
+		size_type count = 0;
+		const auto reload = [&name, &count](const auto& map, const auto& decode_slot) -> void
+		{
+			// fonts of different sizes share a file, compare the paths instead of the keys
+			for (const auto& slot: map | std::views::values)
+			{
+				if (slot->path.lexically_normal().generic_string() == name)
+				{
+					decode_slot(slot);
+					count += 1;
+				}
+			}
+		};
+
+		// the watcher reports the source file, a mounted pack still has the old bytes
+		reload(textures_, [this](const auto& slot) -> void { decode_texture(slot, true); });
+		reload(fonts_, [this](const auto& slot) -> void { decode_font(slot, true); });
+		reload(jsons_, [this](const auto& slot) -> void { decode_json(slot, true); });
+
+		if (count != 0)
+		{
+			SPDLOG_INFO("[ASSET] 重新载入 {} ({} 个资源)", name, count);
+		}
+
+		return count;
+	}
+
+	auto AssetManager::pending() const noexcept -> size_type
+	{
+		return pending_.load(std::memory_order_relaxed);
+	}
+
+	auto AssetManager::update(const UploadBudget& budget) -> size_type
+	{
+		if (watcher_.has_value())
+		{
+			changed_.clear();
+			watcher_->poll(changed_);
+
+			for (const auto& path: changed_)
+			{
+				reload(path);
+			}
+		}
+
+		const auto start = std::chrono::steady_clock::now();
+
+		size_type bytes = 0;
+		size_type count = 0;
+		while (true)
+		{
+			upload_type upload;
+			{
+				std::scoped_lock lock{upload_mutex_};
+
+				if (upload_queue_.empty())
+				{
+					break;
+				}
+
+				if (count != 0)
+				{
+					if (bytes + upload_queue_.front().bytes > budget.bytes or std::chrono::steady_clock::now() - start >= budget.time)
+					{
+						break;
+					}
+				}
+
+				upload = std::move(upload_queue_.front());
+				upload_queue_.pop_front();
+			}
+
+			upload.commit(renderer_);
+
+			bytes += upload.bytes;
+			count += 1;
+		}
+
+		return count;
+	}
+
+	auto AssetManager::collect() -> size_type
+	{
+		// the manager holds the last reference, decoding / uploading assets are referenced by their job
+		const auto unused = [](const auto& pair) noexcept -> bool
+		{
+			return pair.second.use_count() == 1;
+		};
+
+		return std::erase_if(textures_, unused) + std::erase_if(fonts_, unused) + std::erase_if(jsons_, unused);
+	}
+}
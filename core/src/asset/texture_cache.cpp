@@ -0,0 +1,158 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <pb/asset/texture_cache.hpp>
+
+#include <algorithm>
+#include <exception>
+
+#include <pb/macro.hpp>
+#include <pb/platform/os.hpp>
+
+namespace pb::core::asset
+{
+	TextureCache::TextureCache(AssetManager& assets, const size_type budget, const std::uint32_t placeholder_size)
+		: assets_{&assets},
+		  budget_{budget},
+		  placeholder_size_{placeholder_size},
+		  resident_bytes_{0},
+		  frame_{0} {}
+
+	auto TextureCache::id(const std::filesystem::path& path) -> id_type
+	{
+		const auto hash = AssetManager::hash_of(path);
+
+		if (const auto it = ids_.find(hash);
+			it != ids_.end())
+		{
+			return it->second;
+		}
+
+		const auto id = static_cast<id_type>(entries_.size());
+		entries_.push_back({
+				.path = path,
+				.texture = {},
+				.placeholder = assets_->load_thumbnail(path, placeholder_size_),
+				.bytes = 0,
+				.version = 0,
+				.last_used = 0
+		});
+		ids_.emplace(hash, id);
+
+		return id;
+	}
+
+	auto TextureCache::path(const id_type id) const noexcept -> const std::filesystem::path&
+	{
+		PB_ERROR_DEBUG_ASSUME(id < entries_.size());
+
+		return entries_[id].path;
+	}
+
+	auto TextureCache::acquire(const id_type id) -> SDL_Texture*
+	{
+		PB_ERROR_DEBUG_ASSUME(id < entries_.size());
+
+		auto& entry = entries_[id];
+		entry.last_used = frame_;
+
+		if (not entry.texture)
+		{
+			entry.texture = assets_->load_texture(entry.path);
+			resident_.push_back(id);
+		}
+
+		if (const auto* texture = entry.texture.get())
+		{
+			return texture->texture.get();
+		}
+
+		if (const auto* placeholder = entry.placeholder.get())
+		{
+			return placeholder->texture.get();
+		}
+
+		return nullptr;
+	}
+
+	auto TextureCache::resident(const id_type id) const noexcept -> bool
+	{
+		PB_ERROR_DEBUG_ASSUME(id < entries_.size());
+
+		return entries_[id].bytes != 0;
+	}
+
+	auto TextureCache::budget() const noexcept -> size_type
+	{
+		return budget_;
+	}
+
+	auto TextureCache::set_budget(const size_type budget) noexcept -> void
+	{
+		budget_ = budget;
+	}
+
+	auto TextureCache::resident_bytes() const noexcept -> size_type
+	{
+		return resident_bytes_;
+	}
+
+	auto TextureCache::update() -> size_type
+	{
+		// account the textures that became READY (or were reloaded)
+		for (const auto id: resident_)
+		{
+			auto& entry = entries_[id];
+
+			if (const auto* texture = entry.texture.get();
+				texture != nullptr and (entry.bytes == 0 or entry.version != entry.texture.version()))
+			{
+				// decoded as RGBA32
+				const auto bytes = static_cast<size_type>(texture->width) * static_cast<size_type>(texture->height) * 4;
+
+				resident_bytes_ = resident_bytes_ - entry.bytes + bytes;
+				entry.bytes = bytes;
+				entry.version = entry.texture.version();
+			}
+		}
+
+		size_type evicted = 0;
+		if (resident_bytes_ > budget_)
+		{
+			// least recently drawn first
+			std::ranges::sort(resident_, {}, [this](const id_type id) noexcept -> frame_type { return entries_[id].last_used; });
+
+			std::erase_if(
+				resident_,
+				[&](const id_type id) noexcept -> bool
+				{
+					auto& entry = entries_[id];
+
+					// drawn during the previous frame (or still loading)
+					if (resident_bytes_ <= budget_ or entry.last_used >= frame_ or entry.bytes == 0)
+					{
+						return false;
+					}
+
+					resident_bytes_ -= entry.bytes;
+					entry.bytes = 0;
+					entry.version = 0;
+					entry.texture = {};
+
+					evicted += 1;
+					return true;
+				}
+			);
+
+			if (evicted != 0)
+			{
+				assets_->collect();
+			}
+		}
+
+		frame_ += 1;
+		return evicted;
+	}
+}
@@ -1,10 +1,14 @@
 #include <ciso646>
+#include <filesystem>
+#include <system_error>
 
 #include <pb/utility/guard.hpp>
+#include <pb/asset/asset_manager.hpp>
 
 #include <spdlog/spdlog.h>
 
 #include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
 
 #include <imgui.h>
 #include <imgui_impl_sdl3.h>
@@ -71,8 +75,47 @@ auto main() noexcept -> int
 	// 设置逻辑分辨率 (窗口大小 * 逻辑缩放比例)
 	SDL_SetRenderLogicalPresentation(renderer, window_logical_width, window_logical_height, SDL_LOGICAL_PRESENTATION_LETTERBOX);
 
+	if (not TTF_Init())
+	{
+		SPDLOG_ERROR("[SDL_ttf] 初始化失败! {}", SDL_GetError());
+		return -6;
+	}
+	const auto ttf_quit = Guard<void, &TTF_Quit>{};
+
 	SPDLOG_INFO("[SDL] 初始化完成!");
 
+	// ==============================================
+	// ASSET
+	// ==============================================
+
+	// 后台解码, 每帧在主线程按预算上传
+	pb::core::asset::AssetManager asset_manager{renderer};
+
+	// 优先从资源包读取 (由 pb-pack 生成)
+	if (std::error_code error; std::filesystem::exists("assets.pbpack", error))
+	{
+		try
+		{
+			asset_manager.mount(pb::infra::utility::Pack{"assets.pbpack"});
+		}
+		catch (const pb::infra::utility::PackError& exception)
+		{
+			SPDLOG_WARN("[ASSET] 载入资源包失败! {}", exception.what());
+		}
+	}
+
+#if not defined(NDEBUG)
+	// 调试时修改资源文件后自动重新载入
+	try
+	{
+		asset_manager.enable_hot_reload();
+	}
+	catch (const pb::infra::platform::OsError& exception)
+	{
+		SPDLOG_WARN("[ASSET] 启用热重载失败! {}", exception.what());
+	}
+#endif
+
 	// ==============================================
 	// IMGUI
 	// ==============================================
@@ -120,11 +163,33 @@ auto main() noexcept -> int
 
 	SPDLOG_INFO("[IMGUI] 初始化完成!");
 
+	// 空闲模式: 没有输入, 没有 ImGui 交互/动画, 也没有待处理的资源时, 阻塞在 SDL_WaitEventTimeout 中并跳过整帧 (不构建 ImGui, 不清屏, 不呈现)
+	// 每次唤醒后继续渲染几帧, ImGui 需要几帧来完成悬停高亮, 布局等过渡
+	// 只能识别上面列出的情况, 其他随时间变化的内容 (动画, 播放中的声音对应的画面...) 需要通过 continuous_rendering 请求连续渲染
+	constexpr int idle_wake_frames = 3;
+	// 空闲时的最长阻塞时间, 用于轮询资源热重载
+	constexpr int idle_wait_timeout_ms = 250;
+
+	int active_frames = idle_wake_frames;
+	// 场景 (或窗口) 有动画时每帧置为 true, 此时不进入空闲模式
+	bool continuous_rendering = false;
+	// 鼠标静止悬停在控件上的时间 (秒), 延迟显示的提示 (tooltip) 要在这段时间内持续渲染才会出现
+	float hover_seconds = 0;
+
+	// 默认关闭, 打开时一直在连续渲染
+	bool show_demo_window = false;
+
 	bool should_close = false;
 	while (not should_close)
 	{
+		const auto idle = not continuous_rendering and active_frames <= 0 and asset_manager.pending() == 0;
+
 		SDL_Event event;
-		while (SDL_PollEvent(&event))
+		for (
+			auto has_event = idle ? SDL_WaitEventTimeout(&event, idle_wait_timeout_ms) : SDL_PollEvent(&event);
+			has_event;
+			has_event = SDL_PollEvent(&event)
+		)
 		{
 			ImGui_ImplSDL3_ProcessEvent(&event);
 
@@ -135,17 +200,40 @@ auto main() noexcept -> int
 
 			// 其他事件处理，如键盘、鼠标
 			// 可以传递给 current_scene->handle_event(event);
+
+			active_frames = idle_wake_frames;
+		}
+
+		// 上传已解码的资源 (在 ImGui 帧之外, 空闲时也要轮询热重载)
+		if (asset_manager.update() != 0)
+		{
+			active_frames = idle_wake_frames;
+		}
+
+		if (not continuous_rendering and active_frames <= 0 and asset_manager.pending() == 0)
+		{
+			// 什么都没有变化, 上一帧的画面仍然有效
+			continue;
 		}
 
 		ImGui_ImplSDL3_NewFrame();
 		ImGui::NewFrame();
 
+		continuous_rendering = false;
+
 		// 更新场景
 		// current_scene->update(delta_time);
+		// 场景有动画时: continuous_rendering = true;
 
-		ImGui::ShowDemoWindow();
+		if (show_demo_window)
+		{
+			// 演示窗口中有一直在动的图表/进度条
+			ImGui::ShowDemoWindow(&show_demo_window);
+			continuous_rendering = true;
+		}
 		ImGui::Begin("test");
 		ImGui::Text("你好世界!");
+		ImGui::Checkbox("ImGui Demo", &show_demo_window);
 		ImGui::End();
 
 		// 渲染
@@ -159,6 +247,30 @@ auto main() noexcept -> int
 
 		// 交换缓冲区
 		SDL_RenderPresent(renderer);
+
+		// 悬停计时由 ImGui 按帧累加, 鼠标不动时没有事件, 延迟结束前需要一直渲染 (多等一帧让提示显示出来)
+		if (ImGui::IsAnyItemHovered() and io.MouseDelta.x == 0 and io.MouseDelta.y == 0)
+		{
+			hover_seconds += io.DeltaTime;
+		}
+		else
+		{
+			hover_seconds = 0;
+		}
+		const auto& style = ImGui::GetStyle();
+		const auto hover_pending = ImGui::IsAnyItemHovered() and hover_seconds <= style.HoverStationaryDelay + style.HoverDelayNormal;
+
+		// 正在拖动/编辑的控件, 文本输入 (光标闪烁) 或者等待显示的提示需要连续渲染
+		// 滚轮不需要检查, 滚轮事件本身已经唤醒了后续几帧 (而且 ImGui::Render 之后 io.MouseWheel 已经被清零)
+		if (ImGui::IsAnyItemActive() or io.WantTextInput or hover_pending)
+		{
+			active_frames = idle_wake_frames;
+		}
+		else if (active_frames > 0)
+		{
+			// 连续渲染时不会停在 0, 需要防止溢出
+			active_frames -= 1;
+		}
 	}
 
 	return 0;
@@ -0,0 +1,138 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <pb/render/camera.hpp>
+
+#include <cmath>
+#include <exception>
+
+#include <pb/macro.hpp>
+#include <pb/platform/os.hpp>
+
+namespace pb::core::render
+{
+	auto Camera2D::refresh() noexcept -> void
+	{
+		const auto [sin, cos] = rotation_.sincos();
+		const glm::vec2 position = position_;
+		const auto center = viewport_ * .5f;
+
+		// screen = rotate(world - position, -rotation) * zoom + center
+		const glm::vec2 x_axis{cos * zoom_, -sin * zoom_};
+		const glm::vec2 y_axis{sin * zoom_, cos * zoom_};
+		world_to_screen_ = {x_axis, y_axis, center - (x_axis * position.x + y_axis * position.y)};
+
+		// world = rotate(screen - center, rotation) / zoom + position
+		const glm::vec2 inverse_x_axis{cos / zoom_, sin / zoom_};
+		const glm::vec2 inverse_y_axis{-sin / zoom_, cos / zoom_};
+		screen_to_world_ = {inverse_x_axis, inverse_y_axis, position - (inverse_x_axis * center.x + inverse_y_axis * center.y)};
+
+		// bounds of the rotated viewport
+		const auto abs_sin = std::abs(sin);
+		const auto abs_cos = std::abs(cos);
+		const glm::vec2 half_extent{
+				(abs_cos * center.x + abs_sin * center.y) / zoom_,
+				(abs_sin * center.x + abs_cos * center.y) / zoom_
+		};
+		view_ = math::AABB::from_center(position, half_extent);
+	}
+
+	Camera2D::Camera2D(const glm::vec2& viewport, const math::Position& position, const math::Angle rotation, const value_type zoom) noexcept
+		: viewport_{viewport},
+		  position_{position},
+		  rotation_{rotation},
+		  zoom_{zoom}
+	{
+		PB_ERROR_DEBUG_ASSUME(zoom > 0);
+
+		refresh();
+	}
+
+	auto Camera2D::viewport() const noexcept -> const glm::vec2&
+	{
+		return viewport_;
+	}
+
+	auto Camera2D::set_viewport(const glm::vec2& viewport) noexcept -> void
+	{
+		viewport_ = viewport;
+		refresh();
+	}
+
+	auto Camera2D::position() const noexcept -> const math::Position&
+	{
+		return position_;
+	}
+
+	auto Camera2D::set_position(const math::Position& position) noexcept -> void
+	{
+		position_ = position;
+		refresh();
+	}
+
+	auto Camera2D::move(const glm::vec2& offset) noexcept -> void
+	{
+		set_position(math::Position{glm::vec2{position_} + offset});
+	}
+
+	auto Camera2D::rotation() const noexcept -> math::Angle
+	{
+		return rotation_;
+	}
+
+	auto Camera2D::set_rotation(const math::Angle rotation) noexcept -> void
+	{
+		rotation_ = rotation;
+		refresh();
+	}
+
+	auto Camera2D::zoom() const noexcept -> value_type
+	{
+		return zoom_;
+	}
+
+	auto Camera2D::set_zoom(const value_type zoom) noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(zoom > 0);
+
+		zoom_ = zoom;
+		refresh();
+	}
+
+	auto Camera2D::world_to_screen() const noexcept -> const Transform2D&
+	{
+		return world_to_screen_;
+	}
+
+	auto Camera2D::screen_to_world() const noexcept -> const Transform2D&
+	{
+		return screen_to_world_;
+	}
+
+	auto Camera2D::view() const noexcept -> const math::AABB&
+	{
+		return view_;
+	}
+
+	auto Camera2D::to_screen(const glm::vec2& world) const noexcept -> glm::vec2
+	{
+		return world_to_screen_.apply(world);
+	}
+
+	auto Camera2D::to_world(const glm::vec2& screen) const noexcept -> glm::vec2
+	{
+		return screen_to_world_.apply(screen);
+	}
+
+	auto Camera2D::visible(const math::AABB& bounds) const noexcept -> bool
+	{
+		return view_.overlaps(bounds);
+	}
+
+	auto Camera2D::visible(const glm::vec2& center, const value_type radius) const noexcept -> bool
+	{
+		return view_.overlaps(math::AABB::from_center(center, {radius, radius}));
+	}
+}
@@ -0,0 +1,475 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <pb/render/command_queue.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <exception>
+#include <utility>
+
+#include <pb/macro.hpp>
+#include <pb/platform/os.hpp>
+
+#include <glm/geometric.hpp>
+#include <glm/vec2.hpp>
+
+namespace
+{
+	using namespace pb::core::render;
+
+	// commands of the same texture share a key, different textures only need to differ most of the time (a collision only costs a draw call)
+	[[nodiscard]] auto texture_key(const void* texture) noexcept -> std::uint32_t
+	{
+		// murmur3 fmix64
+		auto value = static_cast<std::uint64_t>(std::bit_cast<std::uintptr_t>(texture));
+		value ^= value >> 33;
+		value *= 0xff51afd7ed558ccd;
+		value ^= value >> 33;
+		value *= 0xc4ceb9fe1a85ec53;
+		value ^= value >> 33;
+
+		return static_cast<std::uint32_t>(value);
+	}
+
+	[[nodiscard]] constexpr auto sdl_blend_mode(const BlendMode mode) noexcept -> SDL_BlendMode
+	{
+		switch (mode)
+		{
+			case BlendMode::NONE:
+			{
+				return SDL_BLENDMODE_NONE;
+			}
+			case BlendMode::BLEND:
+			{
+				return SDL_BLENDMODE_BLEND;
+			}
+			case BlendMode::BLEND_PREMULTIPLIED:
+			{
+				return SDL_BLENDMODE_BLEND_PREMULTIPLIED;
+			}
+			case BlendMode::ADD:
+			{
+				return SDL_BLENDMODE_ADD;
+			}
+			case BlendMode::MOD:
+			{
+				return SDL_BLENDMODE_MOD;
+			}
+			case BlendMode::MUL:
+			{
+				return SDL_BLENDMODE_MUL;
+			}
+		}
+
+		PB_COMPILER_UNREACHABLE();
+	}
+
+	// LSD radix sort on the 8 bytes of `key`, stable, the bytes shared by every key are skipped
+	template<typename Entry>
+	auto radix_sort(std::vector<Entry>& entries, std::vector<Entry>& scratch) -> void
+	{
+		if (entries.size() < 2)
+		{
+			return;
+		}
+
+		constexpr std::size_t passes = sizeof(Entry::key);
+
+		std::array<std::array<std::uint32_t, 256>, passes> histograms{};
+		for (const auto& entry: entries)
+		{
+			for (std::size_t pass = 0; pass < passes; ++pass)
+			{
+				histograms[pass][(entry.key >> (pass * 8)) & 0xff] += 1;
+			}
+		}
+
+		scratch.resize(entries.size());
+
+		auto* from = entries.data();
+		auto* to = scratch.data();
+		for (std::size_t pass = 0; pass < passes; ++pass)
+		{
+			auto& histogram = histograms[pass];
+			const auto shift = pass * 8;
+
+			if (histogram[(from->key >> shift) & 0xff] == entries.size())
+			{
+				continue;
+			}
+
+			std::uint32_t offset = 0;
+			for (auto& count: histogram)
+			{
+				offset += std::exchange(count, offset);
+			}
+
+			for (std::size_t i = 0; i < entries.size(); ++i)
+			{
+				const auto& entry = from[i];
+				to[histogram[(entry.key >> shift) & 0xff]++] = entry;
+			}
+
+			std::swap(from, to);
+		}
+
+		if (from != entries.data())
+		{
+			entries.swap(scratch);
+		}
+	}
+}
+
+namespace pb::core::render
+{
+	auto CommandBuffer::push(const DrawOrder& order, SDL_Texture* texture, const std::uint32_t texture_key, command_queue_detail::data_type&& data) -> void
+	{
+		keys_.push_back(command_queue_detail::make_key(order, texture_key));
+		commands_.push_back({.data = std::move(data), .texture = texture, .blend = order.blend, .clip = clip_});
+	}
+
+	auto CommandBuffer::clear() noexcept -> void
+	{
+		keys_.clear();
+		commands_.clear();
+		vertices_.clear();
+		indices_.clear();
+		clips_.clear();
+		clip_ = 0;
+	}
+
+	CommandBuffer::CommandBuffer() noexcept
+		: clip_{0} {}
+
+	auto CommandBuffer::size() const noexcept -> size_type
+	{
+		return commands_.size();
+	}
+
+	auto CommandBuffer::set_clip(const SDL_Rect& rect) -> void
+	{
+		if (clip_ != 0)
+		{
+			if (const auto& current = clips_[clip_ - 1];
+				current.x == rect.x and current.y == rect.y and current.w == rect.w and current.h == rect.h)
+			{
+				return;
+			}
+		}
+
+		clips_.push_back(rect);
+		clip_ = static_cast<std::uint32_t>(clips_.size());
+	}
+
+	auto CommandBuffer::reset_clip() noexcept -> void
+	{
+		clip_ = 0;
+	}
+
+	auto CommandBuffer::sprite(
+		const DrawOrder& order,
+		SDL_Texture* texture,
+		const SDL_FRect& destination,
+		const SDL_FRect* source,
+		const math::Angle rotation,
+		const SDL_FColor& color
+	) -> void
+	{
+		push(
+			order,
+			texture,
+			texture_key(texture),
+			command_queue_detail::sprite_type{
+					.source = source ? *source : SDL_FRect{},
+					.destination = destination,
+					.rotation = rotation,
+					.color = color,
+					.has_source = source != nullptr
+			}
+		);
+	}
+
+	auto CommandBuffer::sprite(
+		const DrawOrder& order,
+		SDL_Texture* texture,
+		const Camera2D& camera,
+		const SDL_FRect& destination,
+		const SDL_FRect* source,
+		const math::Angle rotation,
+		const SDL_FColor& color
+	) -> bool
+	{
+		const glm::vec2 half{destination.w * .5f, destination.h * .5f};
+		const glm::vec2 center{destination.x + half.x, destination.y + half.y};
+
+		// the bounding circle covers every rotation of the sprite
+		if (not camera.visible(center, glm::length(half)))
+		{
+			return false;
+		}
+
+		// the camera only rotates and scales uniformly, the sprite stays a rotated rectangle on screen
+		const auto screen_center = camera.to_screen(center);
+		const auto screen_half = half * camera.zoom();
+
+		sprite(
+			order,
+			texture,
+			{screen_center.x - screen_half.x, screen_center.y - screen_half.y, screen_half.x * 2, screen_half.y * 2},
+			source,
+			rotation - camera.rotation(),
+			color
+		);
+		return true;
+	}
+
+	auto CommandBuffer::geometry(const DrawOrder& order, SDL_Texture* texture, const std::span<const SDL_Vertex> vertices, const std::span<const int> indices) -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(indices.empty() ? vertices.size() % 3 == 0 : indices.size() % 3 == 0);
+
+		const command_queue_detail::geometry_type geometry{
+				.vertex_offset = static_cast<std::uint32_t>(vertices_.size()),
+				.vertex_count = static_cast<std::uint32_t>(vertices.size()),
+				.index_offset = static_cast<std::uint32_t>(indices_.size()),
+				.index_count = static_cast<std::uint32_t>(indices.size())
+		};
+
+		vertices_.insert(vertices_.end(), vertices.begin(), vertices.end());
+		indices_.insert(indices_.end(), indices.begin(), indices.end());
+
+		push(order, texture, texture_key(texture), geometry);
+	}
+
+	auto CommandBuffer::text(const DrawOrder& order, TTF_Text* text, const float x, const float y) -> void
+	{
+		push(order, nullptr, texture_key(text), command_queue_detail::text_type{.text = text, .x = x, .y = y});
+	}
+
+	CommandQueue::CommandQueue() noexcept
+		: acquired_{0} {}
+
+	auto CommandQueue::acquire() -> CommandBuffer&
+	{
+		std::scoped_lock lock{mutex_};
+
+		if (acquired_ == buffers_.size())
+		{
+			buffers_.push_back(std::make_unique<CommandBuffer>());
+		}
+
+		return *buffers_[acquired_++];
+	}
+
+	auto CommandQueue::execute(SDL_Renderer* renderer) -> size_type
+	{
+		// ==============================================
+		// MERGE
+		// ==============================================
+
+		entries_.clear();
+		for (std::uint32_t buffer_index = 0; buffer_index < acquired_; ++buffer_index)
+		{
+			const auto& keys = buffers_[buffer_index]->keys_;
+			for (std::uint32_t command_index = 0; command_index < keys.size(); ++command_index)
+			{
+				entries_.push_back({.key = keys[command_index], .buffer = buffer_index, .command = command_index});
+			}
+		}
+
+		radix_sort(entries_, scratch_);
+
+		// ==============================================
+		// SUBMIT
+		// ==============================================
+
+		size_type draw_calls = 0;
+
+		// the draw blend mode and the clip rect of the caller, restored once every command is submitted
+		SDL_BlendMode previous_blend_mode = SDL_BLENDMODE_NONE;
+		SDL_GetRenderDrawBlendMode(renderer, &previous_blend_mode);
+		SDL_Rect previous_clip_rect{};
+		// the commands that are not clipped use the clip rect of the caller (if any)
+		const SDL_Rect* previous_clip = nullptr;
+		if (SDL_RenderClipEnabled(renderer) and SDL_GetRenderClipRect(renderer, &previous_clip_rect))
+		{
+			previous_clip = &previous_clip_rect;
+		}
+
+		SDL_Texture* batch_texture = nullptr;
+		auto batch_blend = BlendMode::NONE;
+		// size of `batch_texture`, to compute the texture coordinates of the sprites
+		float texture_width = 1;
+		float texture_height = 1;
+
+		const auto flush = [&]
+		{
+			if (indices_.empty())
+			{
+				return;
+			}
+
+			if (batch_texture != nullptr)
+			{
+				SDL_SetTextureBlendMode(batch_texture, sdl_blend_mode(batch_blend));
+			}
+			else
+			{
+				SDL_SetRenderDrawBlendMode(renderer, sdl_blend_mode(batch_blend));
+			}
+
+			SDL_RenderGeometry(
+				renderer,
+				batch_texture,
+				vertices_.data(),
+				static_cast<int>(vertices_.size()),
+				indices_.data(),
+				static_cast<int>(indices_.size())
+			);
+			draw_calls += 1;
+
+			vertices_.clear();
+			indices_.clear();
+		};
+
+		const auto use = [&](SDL_Texture* texture, const BlendMode blend)
+		{
+			if (texture == batch_texture and blend == batch_blend)
+			{
+				return;
+			}
+
+			flush();
+
+			if (texture != batch_texture)
+			{
+				texture_width = 1;
+				texture_height = 1;
+				if (texture != nullptr)
+				{
+					SDL_GetTextureSize(texture, &texture_width, &texture_height);
+				}
+			}
+
+			batch_texture = texture;
+			batch_blend = blend;
+		};
+
+		const SDL_Rect* current_clip = previous_clip;
+		const auto clip_to = [&](const SDL_Rect* clip)
+		{
+			if (clip == current_clip)
+			{
+				return;
+			}
+
+			if (clip != nullptr and current_clip != nullptr and
+			    clip->x == current_clip->x and clip->y == current_clip->y and clip->w == current_clip->w and clip->h == current_clip->h)
+			{
+				current_clip = clip;
+				return;
+			}
+
+			flush();
+
+			SDL_SetRenderClipRect(renderer, clip);
+			current_clip = clip;
+		};
+
+		for (const auto& entry: entries_)
+		{
+			const auto& buffer = *buffers_[entry.buffer];
+			const auto& command = buffer.commands_[entry.command];
+
+			clip_to(command.clip == 0 ? previous_clip : &buffer.clips_[command.clip - 1]);
+
+			if (const auto* sprite = std::get_if<command_queue_detail::sprite_type>(&command.data))
+			{
+				use(command.texture, command.blend);
+
+				const auto& destination = sprite->destination;
+
+				const glm::vec2 center{destination.x + destination.w * .5f, destination.y + destination.h * .5f};
+				const glm::vec2 half{destination.w * .5f, destination.h * .5f};
+
+				// top-left, top-right, bottom-right, bottom-left
+				std::array<glm::vec2, 4> corners{{{-half.x, -half.y}, {half.x, -half.y}, {half.x, half.y}, {-half.x, half.y}}};
+				if (sprite->rotation != math::Angle::zero())
+				{
+					for (auto& corner: corners)
+					{
+						corner = sprite->rotation.rotate_point(corner);
+					}
+				}
+
+				auto u0 = 0.f;
+				auto v0 = 0.f;
+				auto u1 = 1.f;
+				auto v1 = 1.f;
+				if (sprite->has_source)
+				{
+					u0 = sprite->source.x / texture_width;
+					v0 = sprite->source.y / texture_height;
+					u1 = (sprite->source.x + sprite->source.w) / texture_width;
+					v1 = (sprite->source.y + sprite->source.h) / texture_height;
+				}
+
+				const auto base = static_cast<int>(vertices_.size());
+
+				vertices_.push_back({.position = {center.x + corners[0].x, center.y + corners[0].y}, .color = sprite->color, .tex_coord = {u0, v0}});
+				vertices_.push_back({.position = {center.x + corners[1].x, center.y + corners[1].y}, .color = sprite->color, .tex_coord = {u1, v0}});
+				vertices_.push_back({.position = {center.x + corners[2].x, center.y + corners[2].y}, .color = sprite->color, .tex_coord = {u1, v1}});
+				vertices_.push_back({.position = {center.x + corners[3].x, center.y + corners[3].y}, .color = sprite->color, .tex_coord = {u0, v1}});
+
+				indices_.insert(indices_.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+			}
+			else if (const auto* geometry = std::get_if<command_queue_detail::geometry_type>(&command.data))
+			{
+				use(command.texture, command.blend);
+
+				const auto base = static_cast<int>(vertices_.size());
+
+				const auto vertices = std::span{buffer.vertices_}.subspan(geometry->vertex_offset, geometry->vertex_count);
+				vertices_.insert(vertices_.end(), vertices.begin(), vertices.end());
+
+				if (geometry->index_count == 0)
+				{
+					for (int i = 0; i < static_cast<int>(geometry->vertex_count); ++i)
+					{
+						indices_.push_back(base + i);
+					}
+				}
+				else
+				{
+					for (const auto index: std::span{buffer.indices_}.subspan(geometry->index_offset, geometry->index_count))
+					{
+						indices_.push_back(base + index);
+					}
+				}
+			}
+			else
+			{
+				const auto& text = std::get<command_queue_detail::text_type>(command.data);
+
+				flush();
+				TTF_DrawRendererText(text.text, text.x, text.y);
+				draw_calls += 1;
+			}
+		}
+
+		flush();
+		clip_to(previous_clip);
+		SDL_SetRenderDrawBlendMode(renderer, previous_blend_mode);
+
+		for (std::size_t i = 0; i < acquired_; ++i)
+		{
+			buffers_[i]->clear();
+		}
+		acquired_ = 0;
+
+		return draw_calls;
+	}
+}
@@ -0,0 +1,448 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <pb/render/particle_system.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include <pb/math/angle_batch.hpp>
+
+#if defined(__SSE2__) or defined(_M_X64) or (defined(_M_IX86_FP) and _M_IX86_FP >= 2)
+#define PB_RENDER_PARTICLE_SYSTEM_SSE2 1
+#include <emmintrin.h>
+#else
+#define PB_RENDER_PARTICLE_SYSTEM_SSE2 0
+#endif
+
+namespace
+{
+	using namespace pb::core::render;
+
+	using size_type = ParticleSystem::size_type;
+
+	// `Angle` is a single float, the rotations are integrated as an array of degrees
+	static_assert(sizeof(pb::math::Angle) == sizeof(float) and std::is_standard_layout_v<pb::math::Angle>);
+
+	[[nodiscard]] auto degrees_of(std::vector<pb::math::Angle>& angles) noexcept -> float*
+	{
+		return reinterpret_cast<float*>(angles.data());
+	}
+
+	// offsets of the 4 corners (top-left, top-right, bottom-right, bottom-left) of a quad rotated by (sin, cos)
+	// (-h, -h) => (-a + b, -b - a), (h, -h) => (a + b, b - a), (h, h) => (a - b, b + a), (-h, h) => (-a - b, -b + a)
+	// with a = h * cos, b = h * sin
+	struct corners_type
+	{
+		std::array<float, 4> x;
+		std::array<float, 4> y;
+	};
+
+	[[nodiscard]] constexpr auto corners_of(const float a, const float b) noexcept -> corners_type
+	{
+		return {.x = {-a + b, a + b, a - b, -a - b}, .y = {-b - a, b - a, b + a, -b + a}};
+	}
+
+	auto write_quad(SDL_Vertex* vertices, const float x, const float y, const corners_type& corners, const SDL_FColor& color) noexcept -> void
+	{
+		for (std::size_t corner = 0; corner < 4; ++corner)
+		{
+			vertices[corner].position = {x + corners.x[corner], y + corners.y[corner]};
+			vertices[corner].color = color;
+		}
+	}
+
+	// the quad centered on (x, y) in world space, drawn in screen space
+	auto write_quad(SDL_Vertex* vertices, const float x, const float y, const corners_type& corners, const SDL_FColor& color, const Transform2D& world_to_screen) noexcept -> void
+	{
+		const auto center = world_to_screen.apply({x, y});
+		const auto& x_axis = world_to_screen.x_axis();
+		const auto& y_axis = world_to_screen.y_axis();
+
+		for (std::size_t corner = 0; corner < 4; ++corner)
+		{
+			const auto offset = x_axis * corners.x[corner] + y_axis * corners.y[corner];
+			vertices[corner].position = {center.x + offset.x, center.y + offset.y};
+			vertices[corner].color = color;
+		}
+	}
+
+	[[nodiscard]] constexpr auto color_of(const pb::infra::graphics::Color& color, const float fade) noexcept -> SDL_FColor
+	{
+		constexpr auto scale = 1.f / 255.f;
+
+		return {
+				.r = static_cast<float>(color.red) * scale,
+				.g = static_cast<float>(color.green) * scale,
+				.b = static_cast<float>(color.blue) * scale,
+				.a = static_cast<float>(color.alpha) * scale * fade
+		};
+	}
+}
+
+namespace pb::core::render
+{
+	auto ParticleSystem::compact() noexcept -> void
+	{
+		for (size_type i = 0; i < size_;)
+		{
+			if (remaining_[i] > 0)
+			{
+				i += 1;
+				continue;
+			}
+
+			size_ -= 1;
+			if (i != size_)
+			{
+				x_[i] = x_[size_];
+				y_[i] = y_[size_];
+				velocity_x_[i] = velocity_x_[size_];
+				velocity_y_[i] = velocity_y_[size_];
+				remaining_[i] = remaining_[size_];
+				inverse_lifetime_[i] = inverse_lifetime_[size_];
+				size_of_[i] = size_of_[size_];
+				rotation_[i] = rotation_[size_];
+				spin_[i] = spin_[size_];
+				color_[i] = color_[size_];
+			}
+		}
+	}
+
+	auto ParticleSystem::simulate(const float delta, const size_type begin, const size_type end) noexcept -> size_type
+	{
+		auto* x = x_.data();
+		auto* y = y_.data();
+		auto* velocity_x = velocity_x_.data();
+		auto* velocity_y = velocity_y_.data();
+		auto* remaining = remaining_.data();
+		const auto* inverse_lifetime = inverse_lifetime_.data();
+		const auto* size = size_of_.data();
+		auto* rotation = degrees_of(rotation_);
+		const auto* spin = spin_.data();
+
+		// ==============================================
+		// INTEGRATION
+		// ==============================================
+
+		auto i = begin;
+
+#if PB_RENDER_PARTICLE_SYSTEM_SSE2
+		{
+			const auto v_delta = _mm_set1_ps(delta);
+			const auto v_acceleration_x = _mm_set1_ps(acceleration_.x * delta);
+			const auto v_acceleration_y = _mm_set1_ps(acceleration_.y * delta);
+
+			for (; i + 4 <= end; i += 4)
+			{
+				// semi-implicit euler, the velocity first
+				const auto vx = _mm_add_ps(_mm_loadu_ps(velocity_x + i), v_acceleration_x);
+				const auto vy = _mm_add_ps(_mm_loadu_ps(velocity_y + i), v_acceleration_y);
+				_mm_storeu_ps(velocity_x + i, vx);
+				_mm_storeu_ps(velocity_y + i, vy);
+
+				_mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(vx, v_delta)));
+				_mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(vy, v_delta)));
+
+				_mm_storeu_ps(remaining + i, _mm_sub_ps(_mm_loadu_ps(remaining + i), v_delta));
+				_mm_storeu_ps(rotation + i, _mm_add_ps(_mm_loadu_ps(rotation + i), _mm_mul_ps(_mm_loadu_ps(spin + i), v_delta)));
+			}
+		}
+#endif
+
+		for (; i < end; ++i)
+		{
+			velocity_x[i] += acceleration_.x * delta;
+			velocity_y[i] += acceleration_.y * delta;
+
+			x[i] += velocity_x[i] * delta;
+			y[i] += velocity_y[i] * delta;
+
+			remaining[i] -= delta;
+			rotation[i] += spin[i] * delta;
+		}
+
+		// ==============================================
+		// VERTICES
+		// ==============================================
+
+		// without a camera every alive particle is drawn
+		constexpr auto infinity = std::numeric_limits<float>::infinity();
+		const auto view_center = camera_ ? camera_->view().center() : glm::vec2{0, 0};
+		const auto view_half_extent = camera_ ? camera_->view().size() * .5f : glm::vec2{infinity, infinity};
+
+		// the quads are packed from `begin`
+		auto* output = vertices_.data() + begin * 4;
+		const auto emit_quad = [this, &output](const float quad_x, const float quad_y, const corners_type& corners, const SDL_FColor& color) noexcept -> void
+		{
+			if (camera_)
+			{
+				write_quad(output, quad_x, quad_y, corners, color, camera_->world_to_screen());
+			}
+			else
+			{
+				write_quad(output, quad_x, quad_y, corners, color);
+			}
+
+			output += 4;
+		};
+
+		// sin/cos of a block of rotations (SIMD in `AngleBatch`)
+		std::array<float, chunk_size> sin;
+		std::array<float, chunk_size> cos;
+
+		for (auto block = begin; block < end; block += chunk_size)
+		{
+			const auto block_end = std::ranges::min(block + chunk_size, end);
+			const auto count = block_end - block;
+
+			math::AngleBatch{std::span{rotation_}.subspan(block, count)}.sincos(std::span{sin}.first(count), std::span{cos}.first(count));
+
+			auto j = block;
+
+#if PB_RENDER_PARTICLE_SYSTEM_SSE2
+			{
+				const auto v_zero = _mm_setzero_ps();
+				const auto v_one = _mm_set1_ps(1.f);
+				const auto v_half = _mm_set1_ps(.5f);
+				// the distance from the center to a corner
+				const auto v_sqrt2 = _mm_set1_ps(1.41421356f);
+				const auto v_abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fff'ffff));
+
+				const auto v_view_x = _mm_set1_ps(view_center.x);
+				const auto v_view_y = _mm_set1_ps(view_center.y);
+				const auto v_view_half_x = _mm_set1_ps(view_half_extent.x);
+				const auto v_view_half_y = _mm_set1_ps(view_half_extent.y);
+
+				for (; j + 4 <= block_end; j += 4)
+				{
+					const auto v_remaining = _mm_loadu_ps(remaining + j);
+					const auto half = _mm_mul_ps(_mm_loadu_ps(size + j), v_half);
+					const auto radius = _mm_mul_ps(half, v_sqrt2);
+
+					// alive and |position - view center| <= view half extent + radius on both axes
+					const auto alive = _mm_cmpgt_ps(v_remaining, v_zero);
+					const auto inside_x = _mm_cmple_ps(_mm_and_ps(_mm_sub_ps(_mm_loadu_ps(x + j), v_view_x), v_abs_mask), _mm_add_ps(v_view_half_x, radius));
+					const auto inside_y = _mm_cmple_ps(_mm_and_ps(_mm_sub_ps(_mm_loadu_ps(y + j), v_view_y), v_abs_mask), _mm_add_ps(v_view_half_y, radius));
+
+					const auto mask = _mm_movemask_ps(_mm_and_ps(alive, _mm_and_ps(inside_x, inside_y)));
+					if (mask == 0)
+					{
+						continue;
+					}
+
+					const auto a = _mm_mul_ps(half, _mm_loadu_ps(cos.data() + (j - block)));
+					const auto b = _mm_mul_ps(half, _mm_loadu_ps(sin.data() + (j - block)));
+
+					const auto fade = _mm_min_ps(_mm_max_ps(_mm_mul_ps(v_remaining, _mm_loadu_ps(inverse_lifetime + j)), v_zero), v_one);
+
+					alignas(16) std::array<float, 4> a_x;
+					alignas(16) std::array<float, 4> b_y;
+					alignas(16) std::array<float, 4> fades;
+					_mm_store_ps(a_x.data(), a);
+					_mm_store_ps(b_y.data(), b);
+					_mm_store_ps(fades.data(), fade);
+
+					for (std::size_t lane = 0; lane < 4; ++lane)
+					{
+						if ((mask & (1 << lane)) == 0)
+						{
+							continue;
+						}
+
+						const auto index = j + lane;
+						emit_quad(x[index], y[index], corners_of(a_x[lane], b_y[lane]), color_of(color_[index], fades[lane]));
+					}
+				}
+			}
+#endif
+
+			for (; j < block_end; ++j)
+			{
+				if (remaining[j] <= 0)
+				{
+					continue;
+				}
+
+				const auto half = size[j] * .5f;
+				const auto radius = half * 1.41421356f;
+				if (std::abs(x[j] - view_center.x) > view_half_extent.x + radius or std::abs(y[j] - view_center.y) > view_half_extent.y + radius)
+				{
+					continue;
+				}
+
+				const auto fade = std::clamp(remaining[j] * inverse_lifetime[j], 0.f, 1.f);
+
+				emit_quad(x[j], y[j], corners_of(half * cos[j - block], half * sin[j - block]), color_of(color_[j], fade));
+			}
+		}
+
+		return static_cast<size_type>(output - (vertices_.data() + begin * 4)) / 4;
+	}
+
+	auto ParticleSystem::pack() noexcept -> void
+	{
+		quads_ = 0;
+		for (size_type chunk = 0; chunk < chunk_quads_.size(); ++chunk)
+		{
+			const auto quads = chunk_quads_[chunk];
+			const auto source = chunk * chunk_size;
+
+			if (source != quads_ and quads != 0)
+			{
+				// only the positions and colors differ, the texture coordinates are the same for every quad
+				std::ranges::copy_n(vertices_.begin() + static_cast<std::ptrdiff_t>(source * 4), static_cast<std::ptrdiff_t>(quads * 4), vertices_.begin() + static_cast<std::ptrdiff_t>(quads_ * 4));
+			}
+
+			quads_ += quads;
+		}
+	}
+
+	ParticleSystem::ParticleSystem(const size_type capacity)
+		: capacity_{capacity},
+		  size_{0},
+		  acceleration_{0, 0},
+		  x_(capacity),
+		  y_(capacity),
+		  velocity_x_(capacity),
+		  velocity_y_(capacity),
+		  remaining_(capacity),
+		  inverse_lifetime_(capacity),
+		  size_of_(capacity),
+		  rotation_(capacity, math::Angle::zero()),
+		  spin_(capacity),
+		  color_(capacity),
+		  camera_{nullptr},
+		  vertices_(capacity * 4),
+		  indices_(capacity * 6),
+		  quads_{0}
+	{
+		for (size_type i = 0; i < capacity; ++i)
+		{
+			auto* vertices = vertices_.data() + i * 4;
+			vertices[0].tex_coord = {0, 0};
+			vertices[1].tex_coord = {1, 0};
+			vertices[2].tex_coord = {1, 1};
+			vertices[3].tex_coord = {0, 1};
+
+			const auto base = static_cast<int>(i * 4);
+			std::ranges::copy(std::array{base, base + 1, base + 2, base, base + 2, base + 3}, indices_.begin() + static_cast<std::ptrdiff_t>(i * 6));
+		}
+	}
+
+	auto ParticleSystem::capacity() const noexcept -> size_type
+	{
+		return capacity_;
+	}
+
+	auto ParticleSystem::size() const noexcept -> size_type
+	{
+		return size_;
+	}
+
+	auto ParticleSystem::empty() const noexcept -> bool
+	{
+		return size_ == 0;
+	}
+
+	auto ParticleSystem::acceleration() const noexcept -> const glm::vec2&
+	{
+		return acceleration_;
+	}
+
+	auto ParticleSystem::set_acceleration(const glm::vec2& acceleration) noexcept -> void
+	{
+		acceleration_ = acceleration;
+	}
+
+	auto ParticleSystem::camera() const noexcept -> const Camera2D*
+	{
+		return camera_;
+	}
+
+	auto ParticleSystem::set_camera(const Camera2D* camera) noexcept -> void
+	{
+		camera_ = camera;
+	}
+
+	auto ParticleSystem::emit(const Particle& particle) noexcept -> bool
+	{
+		if (size_ == capacity_ or particle.lifetime <= 0)
+		{
+			return false;
+		}
+
+		const auto i = size_;
+		size_ += 1;
+
+		x_[i] = particle.position.x();
+		y_[i] = particle.position.y();
+		velocity_x_[i] = particle.velocity.x;
+		velocity_y_[i] = particle.velocity.y;
+		remaining_[i] = particle.lifetime;
+		inverse_lifetime_[i] = 1.f / particle.lifetime;
+		size_of_[i] = particle.size;
+		rotation_[i] = particle.rotation;
+		spin_[i] = particle.spin.value();
+		color_[i] = particle.color;
+
+		return true;
+	}
+
+	auto ParticleSystem::clear() noexcept -> void
+	{
+		size_ = 0;
+		quads_ = 0;
+	}
+
+	auto ParticleSystem::drawn() const noexcept -> size_type
+	{
+		return quads_;
+	}
+
+	auto ParticleSystem::vertices() const noexcept -> std::span<const SDL_Vertex>
+	{
+		return std::span{vertices_}.first(quads_ * 4);
+	}
+
+	auto ParticleSystem::indices() const noexcept -> std::span<const int>
+	{
+		return std::span{indices_}.first(quads_ * 6);
+	}
+
+	auto ParticleSystem::update(const float delta) noexcept -> void
+	{
+		update(
+			delta,
+			[](const std::size_t chunk_count, const auto& job) noexcept -> void
+			{
+				for (std::size_t chunk = 0; chunk < chunk_count; ++chunk)
+				{
+					job(chunk);
+				}
+			}
+		);
+	}
+
+	auto ParticleSystem::render(SDL_Renderer* renderer, SDL_Texture* texture) const -> void
+	{
+		if (quads_ == 0)
+		{
+			return;
+		}
+
+		SDL_RenderGeometry(
+			renderer,
+			texture,
+			vertices_.data(),
+			static_cast<int>(quads_ * 4),
+			indices_.data(),
+			static_cast<int>(quads_ * 6)
+		);
+	}
+}
@@ -0,0 +1,104 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <pb/render/render_layer.hpp>
+
+#include <spdlog/spdlog.h>
+
+namespace pb::core::render
+{
+	auto RenderLayer::prepare(SDL_Renderer* renderer) -> bool
+	{
+		if (direct_)
+		{
+			return false;
+		}
+
+		if (texture_ == nullptr)
+		{
+			texture_.reset(SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, width_, height_));
+			if (texture_ == nullptr)
+			{
+				SPDLOG_WARN("[RENDER] 创建渲染目标纹理失败, 图层将每帧直接绘制! {}", SDL_GetError());
+
+				direct_ = true;
+				return false;
+			}
+
+			// the layer is drawn with BLEND onto transparent black, the texture holds premultiplied colors
+			SDL_SetTextureBlendMode(texture_.get(), SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+			dirty_ = true;
+		}
+
+		return true;
+	}
+
+	auto RenderLayer::begin(SDL_Renderer* renderer) -> void
+	{
+		previous_target_ = SDL_GetRenderTarget(renderer);
+		SDL_GetRenderDrawColor(renderer, &previous_color_.r, &previous_color_.g, &previous_color_.b, &previous_color_.a);
+
+		SDL_SetRenderTarget(renderer, texture_.get());
+		SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+		SDL_RenderClear(renderer);
+	}
+
+	auto RenderLayer::end(SDL_Renderer* renderer) -> void
+	{
+		SDL_SetRenderTarget(renderer, previous_target_);
+		SDL_SetRenderDrawColor(renderer, previous_color_.r, previous_color_.g, previous_color_.b, previous_color_.a);
+
+		previous_target_ = nullptr;
+		dirty_ = false;
+	}
+
+	auto RenderLayer::present(SDL_Renderer* renderer, const SDL_FRect* destination) const -> void
+	{
+		SDL_RenderTexture(renderer, texture_.get(), nullptr, destination);
+	}
+
+	RenderLayer::RenderLayer(const size_type width, const size_type height) noexcept
+		: width_{width},
+		  height_{height},
+		  dirty_{true},
+		  direct_{false},
+		  previous_target_{nullptr},
+		  previous_color_{} {}
+
+	auto RenderLayer::width() const noexcept -> size_type
+	{
+		return width_;
+	}
+
+	auto RenderLayer::height() const noexcept -> size_type
+	{
+		return height_;
+	}
+
+	auto RenderLayer::dirty() const noexcept -> bool
+	{
+		return dirty_;
+	}
+
+	auto RenderLayer::mark_dirty() noexcept -> void
+	{
+		dirty_ = true;
+	}
+
+	auto RenderLayer::resize(const size_type width, const size_type height) noexcept -> void
+	{
+		if (width == width_ and height == height_)
+		{
+			return;
+		}
+
+		width_ = width;
+		height_ = height;
+
+		texture_.reset();
+		direct_ = false;
+		dirty_ = true;
+	}
+}
@@ -0,0 +1,222 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <pb/render/tilemap.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+
+#include <pb/macro.hpp>
+#include <pb/platform/os.hpp>
+
+namespace
+{
+	using namespace pb::core::render;
+
+	// [begin, end) of the chunks overlapping [min, max] on one axis
+	struct range_type
+	{
+		Tilemap::size_type begin;
+		Tilemap::size_type end;
+	};
+
+	[[nodiscard]] auto chunk_range(const float min, const float max, const float chunk_extent, const Tilemap::size_type count) noexcept -> range_type
+	{
+		const auto first = std::floor(min / chunk_extent);
+		const auto last = std::floor(max / chunk_extent) + 1;
+
+		const auto clamp = [count](const float value) noexcept -> Tilemap::size_type
+		{
+			return static_cast<Tilemap::size_type>(std::clamp(value, 0.f, static_cast<float>(count)));
+		};
+
+		return {.begin = clamp(first), .end = clamp(last)};
+	}
+}
+
+namespace pb::core::render
+{
+	auto Tilemap::build(const size_type chunk_x, const size_type chunk_y) -> void
+	{
+		auto& chunk = chunks_[chunk_y * chunk_columns_ + chunk_x];
+
+		chunk.vertices.clear();
+		chunk.indices.clear();
+		chunk.dirty = false;
+
+		const auto uv_size = tile_set_.tile_size / tile_set_.texture_size;
+		constexpr SDL_FColor white{.r = 1, .g = 1, .b = 1, .a = 1};
+
+		const auto x_end = std::ranges::min((chunk_x + 1) * chunk_size, width_);
+		const auto y_end = std::ranges::min((chunk_y + 1) * chunk_size, height_);
+
+		for (auto y = chunk_y * chunk_size; y < y_end; ++y)
+		{
+			for (auto x = chunk_x * chunk_size; x < x_end; ++x)
+			{
+				const auto tile = tiles_[static_cast<std::size_t>(y) * width_ + x];
+				if (tile == empty_tile)
+				{
+					continue;
+				}
+
+				const auto index = static_cast<size_type>(tile - 1);
+				const glm::vec2 uv{
+						static_cast<float>(index % tile_set_.columns) * uv_size.x,
+						static_cast<float>(index / tile_set_.columns) * uv_size.y
+				};
+
+				const auto p0 = origin_ + glm::vec2{static_cast<float>(x), static_cast<float>(y)} * tile_size_;
+				const auto p1 = p0 + tile_size_;
+
+				const auto base = static_cast<int>(chunk.vertices.size());
+
+				// top-left, top-right, bottom-right, bottom-left
+				chunk.vertices.push_back({.position = {p0.x, p0.y}, .color = white, .tex_coord = {uv.x, uv.y}});
+				chunk.vertices.push_back({.position = {p1.x, p0.y}, .color = white, .tex_coord = {uv.x + uv_size.x, uv.y}});
+				chunk.vertices.push_back({.position = {p1.x, p1.y}, .color = white, .tex_coord = {uv.x + uv_size.x, uv.y + uv_size.y}});
+				chunk.vertices.push_back({.position = {p0.x, p1.y}, .color = white, .tex_coord = {uv.x, uv.y + uv_size.y}});
+
+				chunk.indices.insert(chunk.indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+			}
+		}
+	}
+
+	Tilemap::Tilemap(const size_type width, const size_type height, const TileSet& tile_set, const glm::vec2& tile_size, const glm::vec2& origin)
+		: width_{width},
+		  height_{height},
+		  chunk_columns_{(width + chunk_size - 1) / chunk_size},
+		  chunk_rows_{(height + chunk_size - 1) / chunk_size},
+		  tile_set_{tile_set},
+		  origin_{origin},
+		  tile_size_{tile_size},
+		  tiles_(static_cast<std::size_t>(width) * height, empty_tile),
+		  chunks_(static_cast<std::size_t>(chunk_columns_) * chunk_rows_)
+	{
+		PB_ERROR_DEBUG_ASSUME(tile_set.columns != 0);
+
+		for (auto& chunk: chunks_)
+		{
+			chunk.dirty = true;
+		}
+	}
+
+	auto Tilemap::width() const noexcept -> size_type
+	{
+		return width_;
+	}
+
+	auto Tilemap::height() const noexcept -> size_type
+	{
+		return height_;
+	}
+
+	auto Tilemap::bounds() const noexcept -> math::AABB
+	{
+		return math::AABB::from_size(origin_, glm::vec2{static_cast<float>(width_), static_cast<float>(height_)} * tile_size_);
+	}
+
+	auto Tilemap::tile(const size_type x, const size_type y) const noexcept -> tile_type
+	{
+		PB_ERROR_DEBUG_ASSUME(x < width_ and y < height_);
+
+		return tiles_[static_cast<std::size_t>(y) * width_ + x];
+	}
+
+	auto Tilemap::set_tile(const size_type x, const size_type y, const tile_type tile) noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(x < width_ and y < height_);
+
+		auto& current = tiles_[static_cast<std::size_t>(y) * width_ + x];
+		if (current == tile)
+		{
+			return;
+		}
+
+		current = tile;
+		chunks_[(y / chunk_size) * chunk_columns_ + x / chunk_size].dirty = true;
+	}
+
+	auto Tilemap::set_tiles(const std::vector<tile_type>& tiles) -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(tiles.size() == tiles_.size());
+
+		tiles_ = tiles;
+		for (auto& chunk: chunks_)
+		{
+			chunk.dirty = true;
+		}
+	}
+
+	auto Tilemap::set_tile_set(const TileSet& tile_set) noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(tile_set.columns != 0);
+
+		tile_set_ = tile_set;
+		for (auto& chunk: chunks_)
+		{
+			chunk.dirty = true;
+		}
+	}
+
+	auto Tilemap::render(SDL_Renderer* renderer, const math::AABB& view, const Transform2D& world_to_screen) -> size_type
+	{
+		const auto chunk_extent = tile_size_ * static_cast<float>(chunk_size);
+
+		const auto columns = chunk_range(view.min().x - origin_.x, view.max().x - origin_.x, chunk_extent.x, chunk_columns_);
+		const auto rows = chunk_range(view.min().y - origin_.y, view.max().y - origin_.y, chunk_extent.y, chunk_rows_);
+
+		const auto identity = world_to_screen.is_identity();
+
+		size_type drawn = 0;
+		for (auto chunk_y = rows.begin; chunk_y < rows.end; ++chunk_y)
+		{
+			for (auto chunk_x = columns.begin; chunk_x < columns.end; ++chunk_x)
+			{
+				auto& chunk = chunks_[chunk_y * chunk_columns_ + chunk_x];
+				if (chunk.dirty)
+				{
+					build(chunk_x, chunk_y);
+				}
+
+				if (chunk.indices.empty())
+				{
+					continue;
+				}
+
+				const auto* vertices = chunk.vertices.data();
+				if (not identity)
+				{
+					transformed_.assign(chunk.vertices.begin(), chunk.vertices.end());
+					for (auto& vertex: transformed_)
+					{
+						const auto position = world_to_screen.apply({vertex.position.x, vertex.position.y});
+						vertex.position = {position.x, position.y};
+					}
+
+					vertices = transformed_.data();
+				}
+
+				SDL_RenderGeometry(
+					renderer,
+					tile_set_.texture,
+					vertices,
+					static_cast<int>(chunk.vertices.size()),
+					chunk.indices.data(),
+					static_cast<int>(chunk.indices.size())
+				);
+				drawn += 1;
+			}
+		}
+
+		return drawn;
+	}
+
+	auto Tilemap::render(SDL_Renderer* renderer, const Camera2D& camera) -> size_type
+	{
+		return render(renderer, camera.view(), camera.world_to_screen());
+	}
+}
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cstdint>
 #include <type_traits>
 #include <tuple>
+#include <utility>
 #include <format>
 
 namespace pb::infra::graphics
@@ -145,39 +147,66 @@ namespace pb::infra::graphics
 			};
 		}
 
+		// 0.299 / 0.587 / 0.114 scaled to 77 / 150 / 29 (sum 256), no float conversion
+		[[nodiscard]] constexpr auto luminance_u8() const noexcept -> value_type
+		{
+			return static_cast<value_type>((77 * red + 150 * green + 29 * blue + 128) >> 8);
+		}
+
+		// 8.8 fixed-point `blend`, `t` in [0, 255] maps to [0, 1] (255 yields `other`)
+		[[nodiscard]] constexpr auto blend_u8(const Color& other, const value_type t) const noexcept -> Color
+		{
+			// [0, 255] => [0, 256]
+			const auto weight = static_cast<std::uint32_t>(t + (t >> 7));
+			const auto inverse_weight = 256 - weight;
+
+			// ReSharper disable once IdentifierTypo
+			const auto lerp = [weight, inverse_weight](const value_type a, const value_type b) noexcept -> value_type
+			{
+				return static_cast<value_type>((a * inverse_weight + b * weight + 128) >> 8);
+			};
+
+			return {
+					lerp(red, other.red),
+					lerp(green, other.green),
+					lerp(blue, other.blue),
+					lerp(alpha, other.alpha)
+			};
+		}
+
 		[[nodiscard]] constexpr auto operator==(const Color&) const noexcept -> bool = default;
 	};
 
 	static_assert(sizeof(Color) == sizeof(universal_32_bit_color_type));
 
-	[[nodiscard]] constexpr auto operator""_rgb(const universal_32_bit_color_type value) noexcept -> Color
+	[[nodiscard]] constexpr auto operator""_rgb(const unsigned long long value) noexcept -> Color
 	{
-		return Color::from<ColorFormat::R_G_B>(value);
+		return Color::from<ColorFormat::R_G_B>(static_cast<universal_32_bit_color_type>(value));
 	}
 
-	[[nodiscard]] constexpr auto operator""_rgba(const universal_32_bit_color_type value) noexcept -> Color
+	[[nodiscard]] constexpr auto operator""_rgba(const unsigned long long value) noexcept -> Color
 	{
-		return Color::from<ColorFormat::R_G_B_A>(value);
+		return Color::from<ColorFormat::R_G_B_A>(static_cast<universal_32_bit_color_type>(value));
 	}
 
-	[[nodiscard]] constexpr auto operator""_argb(const universal_32_bit_color_type value) noexcept -> Color
+	[[nodiscard]] constexpr auto operator""_argb(const unsigned long long value) noexcept -> Color
 	{
-		return Color::from<ColorFormat::A_R_G_B>(value);
+		return Color::from<ColorFormat::A_R_G_B>(static_cast<universal_32_bit_color_type>(value));
 	}
 
-	[[nodiscard]] constexpr auto operator""_bgr(const universal_32_bit_color_type value) noexcept -> Color
+	[[nodiscard]] constexpr auto operator""_bgr(const unsigned long long value) noexcept -> Color
 	{
-		return Color::from<ColorFormat::B_G_R>(value);
+		return Color::from<ColorFormat::B_G_R>(static_cast<universal_32_bit_color_type>(value));
 	}
 
-	[[nodiscard]] constexpr auto operator""_bgra(const universal_32_bit_color_type value) noexcept -> Color
+	[[nodiscard]] constexpr auto operator""_bgra(const unsigned long long value) noexcept -> Color
 	{
-		return Color::from<ColorFormat::B_G_R_A>(value);
+		return Color::from<ColorFormat::B_G_R_A>(static_cast<universal_32_bit_color_type>(value));
 	}
 
-	[[nodiscard]] constexpr auto operator""_abgr(const universal_32_bit_color_type value) noexcept -> Color
+	[[nodiscard]] constexpr auto operator""_abgr(const unsigned long long value) noexcept -> Color
 	{
-		return Color::from<ColorFormat::A_B_G_R>(value);
+		return Color::from<ColorFormat::A_B_G_R>(static_cast<universal_32_bit_color_type>(value));
 	}
 
 	namespace colors
@@ -0,0 +1,207 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#include <pb/graphics/color.hpp>
+
+namespace pb::infra::graphics
+{
+	namespace color_blend_detail
+	{
+		// round(value / 255) for value in [0, 255 * 255]
+		[[nodiscard]] constexpr auto mul_div_255(const std::uint32_t value) noexcept -> std::uint32_t
+		{
+			const auto v = value + 128;
+			return (v + (v >> 8)) >> 8;
+		}
+	}
+
+	// ============================================================
+	// COLOR SPACE
+	// ============================================================
+
+	constexpr std::size_t srgb_to_linear_table_size = 256;
+	constexpr std::size_t linear_to_srgb_table_size = 4096;
+
+	// sRGB byte => linear [0, 1]
+	[[nodiscard]] auto srgb_to_linear_table() noexcept -> const std::array<float, srgb_to_linear_table_size>&;
+
+	// linear [0, 1] quantized to 12 bits => sRGB byte, 12 bits keep every sRGB byte reachable (the darkest step is ~1/3300)
+	[[nodiscard]] auto linear_to_srgb_table() noexcept -> const std::array<Color::value_type, linear_to_srgb_table_size>&;
+
+	[[nodiscard]] auto srgb_to_linear(Color::value_type value) noexcept -> float;
+
+	[[nodiscard]] auto linear_to_srgb(float value) noexcept -> Color::value_type;
+
+	// ============================================================
+	// PREMULTIPLIED COLOR
+	// ============================================================
+
+	/**
+	 * @brief 8-bit sRGB color with premultiplied alpha (every channel <= alpha), same memory layout as `Color`.
+	 *
+	 * Compositing premultiplied colors is a single multiply-add per channel and does not bleed the color of transparent pixels.
+	 */
+	class [[nodiscard]] alignas(std::alignment_of<universal_32_bit_color_type>) PremultipliedColor final
+	{
+	public:
+		using value_type = Color::value_type;
+
+		value_type red;
+		value_type green;
+		value_type blue;
+		value_type alpha;
+
+		[[nodiscard]] constexpr static auto from(const Color& color) noexcept -> PremultipliedColor
+		{
+			const auto multiply = [a = color.alpha](const value_type value) noexcept -> value_type
+			{
+				return static_cast<value_type>(color_blend_detail::mul_div_255(static_cast<std::uint32_t>(value) * a));
+			};
+
+			return {.red = multiply(color.red), .green = multiply(color.green), .blue = multiply(color.blue), .alpha = color.alpha};
+		}
+
+		[[nodiscard]] constexpr auto to_color() const noexcept -> Color
+		{
+			if (alpha == 0)
+			{
+				return {.red = 0, .green = 0, .blue = 0, .alpha = 0};
+			}
+
+			const auto divide = [a = static_cast<std::uint32_t>(alpha)](const value_type value) noexcept -> value_type
+			{
+				const auto result = (static_cast<std::uint32_t>(value) * 255 + a / 2) / a;
+				return static_cast<value_type>(result > 255 ? 255 : result);
+			};
+
+			return {.red = divide(red), .green = divide(green), .blue = divide(blue), .alpha = alpha};
+		}
+
+		// this over `destination` (Porter-Duff source-over)
+		[[nodiscard]] constexpr auto over(const PremultipliedColor& destination) const noexcept -> PremultipliedColor
+		{
+			const auto inverse_alpha = static_cast<std::uint32_t>(255 - alpha);
+
+			const auto compose = [inverse_alpha](const value_type source, const value_type destination_value) noexcept -> value_type
+			{
+				return static_cast<value_type>(source + color_blend_detail::mul_div_255(destination_value * inverse_alpha));
+			};
+
+			return {
+					.red = compose(red, destination.red),
+					.green = compose(green, destination.green),
+					.blue = compose(blue, destination.blue),
+					.alpha = compose(alpha, destination.alpha)
+			};
+		}
+
+		[[nodiscard]] constexpr auto operator==(const PremultipliedColor&) const noexcept -> bool = default;
+	};
+
+	static_assert(sizeof(PremultipliedColor) == sizeof(Color));
+
+	// ============================================================
+	// LINEAR COLOR
+	// ============================================================
+
+	/**
+	 * @brief Linear-light color with premultiplied alpha, every channel in [0, 1].
+	 *
+	 * Blending in linear space keeps the perceived brightness of gradients and antialiased edges, at the cost of two LUT lookups per channel.
+	 */
+	class [[nodiscard]] LinearColor final
+	{
+	public:
+		using value_type = float;
+
+		value_type red;
+		value_type green;
+		value_type blue;
+		value_type alpha;
+
+		[[nodiscard]] static auto from(const Color& color) noexcept -> LinearColor;
+
+		[[nodiscard]] auto to_color() const noexcept -> Color;
+
+		// this over `destination` (Porter-Duff source-over)
+		[[nodiscard]] constexpr auto over(const LinearColor& destination) const noexcept -> LinearColor
+		{
+			const auto inverse_alpha = 1.f - alpha;
+
+			return {
+					.red = red + destination.red * inverse_alpha,
+					.green = green + destination.green * inverse_alpha,
+					.blue = blue + destination.blue * inverse_alpha,
+					.alpha = alpha + destination.alpha * inverse_alpha
+			};
+		}
+
+		[[nodiscard]] constexpr auto blend(const LinearColor& other, const value_type t) const noexcept -> LinearColor
+		{
+			return {
+					.red = red + (other.red - red) * t,
+					.green = green + (other.green - green) * t,
+					.blue = blue + (other.blue - blue) * t,
+					.alpha = alpha + (other.alpha - alpha) * t
+			};
+		}
+
+		[[nodiscard]] constexpr auto operator==(const LinearColor&) const noexcept -> bool = default;
+	};
+
+	// ============================================================
+	// BATCH
+	// ============================================================
+
+	enum class BlendSpace : std::uint8_t
+	{
+		// blend the sRGB bytes directly (cheaper, darkens midtones)
+		SRGB,
+		// blend in linear light
+		LINEAR,
+	};
+
+	// destination[i] = PremultipliedColor::from(source[i]), `source` and `destination` may be the same buffer
+	auto premultiply(std::span<const Color> source, std::span<PremultipliedColor> destination) noexcept -> void;
+
+	// destination[i] = source[i].to_color(), `source` and `destination` may be the same buffer
+	auto unpremultiply(std::span<const PremultipliedColor> source, std::span<Color> destination) noexcept -> void;
+
+	// destination[i] = source[i].over(destination[i])
+	auto over(std::span<const PremultipliedColor> source, std::span<PremultipliedColor> destination) noexcept -> void;
+
+	/**
+	 * @brief out[i] = `from[i]` blended toward `to[i]` by `t`, with premultiplied alpha (a transparent end does not bleed its color) in `space`.
+	 * @note `out` may be the same buffer as `from` or `to`.
+	 */
+	auto blend_span(
+		std::span<const Color> from,
+		std::span<const Color> to,
+		float t,
+		std::span<Color> out,
+		BlendSpace space = BlendSpace::LINEAR
+	) noexcept -> void;
+
+	// ============================================================
+	// FIXED POINT
+	// ============================================================
+
+	// out[i] = from[i].blend_u8(to[i], t), `out` may be the same buffer as `from` or `to`
+	auto blend_u8(std::span<const Color> from, std::span<const Color> to, Color::value_type t, std::span<Color> out) noexcept -> void;
+
+	// out[i] = from[i].blend_u8(to, t), tint / fade a whole buffer toward one color, `out` may be the same buffer as `from`
+	auto blend_u8(std::span<const Color> from, const Color& to, Color::value_type t, std::span<Color> out) noexcept -> void;
+
+	// out[i] = colors[i].luminance_u8()
+	auto luminance_u8(std::span<const Color> colors, std::span<Color::value_type> out) noexcept -> void;
+}
@@ -0,0 +1,39 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <span>
+
+#include <pb/graphics/color.hpp>
+
+namespace pb::infra::graphics
+{
+	/**
+	 * @brief Convert every pixel of `source` from `from` to `to`, same result as `Color::from<from>(pixel).to<to>()`.
+	 *
+	 * Every conversion between two `ColorFormat`s is a byte shuffle (plus a constant alpha for formats without one),
+	 * it is done 8 pixels at a time with AVX2, 4 pixels at a time with SSSE3, and per pixel otherwise.
+	 *
+	 * `destination` must hold at least `source.size()` pixels, `source` and `destination` may be the same buffer (in-place conversion)
+	 * but must not partially overlap.
+	 *
+	 * @code
+	 * // SDL_PIXELFORMAT_ABGR8888 (packed 0xAABBGGRR) surface to A_R_G_B, row by row: rows may be padded (`pitch` is in bytes)
+	 * auto* row = static_cast<std::uint32_t*>(surface->pixels);
+	 * for (int y = 0; y < surface->h; ++y, row += surface->pitch / 4)
+	 * {
+	 *     const std::span pixels{row, static_cast<std::size_t>(surface->w)};
+	 *     convert(pixels, ColorFormat::A_B_G_R, ColorFormat::A_R_G_B, pixels);
+	 * }
+	 * @endcode
+	 */
+	auto convert(
+		std::span<const universal_32_bit_color_type> source,
+		ColorFormat from,
+		ColorFormat to,
+		std::span<universal_32_bit_color_type> destination
+	) noexcept -> void;
+}
@@ -0,0 +1,150 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <pb/graphics/color.hpp>
+#include <pb/platform/exception.hpp>
+
+namespace pb::infra::graphics
+{
+	class ColorLUTError final : public platform::Exception<void>
+	{
+	public:
+		using Exception::Exception;
+
+		[[noreturn]] static auto panic(
+			std::string message,
+			const std::source_location& location = std::source_location::current(),
+			std::stacktrace stacktrace = std::stacktrace::current()
+		) noexcept(false) -> void //
+		{
+			platform::panic<ColorLUTError>(std::move(message), location, std::move(stacktrace));
+		}
+	};
+
+	/**
+	 * @brief A view of 32-bit pixels with the memory layout of `Color` (r, g, b, a bytes, i.e. SDL_PIXELFORMAT_RGBA32).
+	 */
+	struct SurfaceView
+	{
+		Color* pixels;
+		std::uint32_t width;
+		std::uint32_t height;
+		// distance between two rows, in pixels
+		std::uint32_t pitch;
+	};
+
+	/**
+	 * @brief 3D color lookup table (e.g. 32x32x32), the color grading stage of the software / readback path.
+	 *
+	 * Every output color is the trilinear interpolation of the 8 entries around the input color,
+	 * the per-byte lattice coordinates are precomputed so a pixel costs 8 4-float loads and 7 vector lerps (SSE2).
+	 * Alpha is kept as is.
+	 *
+	 * Grading is per pixel, `apply` on disjoint row ranges can run concurrently:
+	 * @code
+	 * lut.apply(
+	 *     surface,
+	 *     64,
+	 *     [&](const std::size_t tile_count, const auto& job) -> void
+	 *     {
+	 *         // any worker pool, tiles are independent
+	 *         std::vector<std::jthread> workers;
+	 *         for (std::size_t i = 0; i < tile_count; ++i) { workers.emplace_back(job, i); }
+	 *     }
+	 * );
+	 * @endcode
+	 */
+	class ColorLUT
+	{
+	public:
+		using value_type = float;
+		using size_type = std::uint32_t;
+
+		// rgb + padding
+		using entry_type = std::array<value_type, 4>;
+
+		constexpr static size_type default_size = 32;
+		constexpr static size_type min_size = 2;
+		constexpr static size_type max_size = 256;
+
+	private:
+		struct axis_type
+		{
+			// lattice index of the lower corner (<= size - 2), already multiplied by the stride of the axis
+			std::uint32_t offset;
+			value_type fraction;
+		};
+
+		size_type size_;
+		// red changes fastest, then green, then blue (.cube order)
+		std::vector<entry_type> entries_;
+
+		std::array<std::array<axis_type, 256>, 3> axes_;
+
+		auto build_axes(const entry_type& domain_min, const entry_type& domain_max) noexcept -> void;
+
+	public:
+		ColorLUT(size_type size, std::vector<entry_type> entries, const entry_type& domain_min = {0, 0, 0, 0}, const entry_type& domain_max = {1, 1, 1, 0});
+
+		// output == input
+		[[nodiscard]] static auto identity(size_type size = default_size) -> ColorLUT;
+
+		/**
+		 * @brief Parse the content of a .cube file (LUT_3D_SIZE, DOMAIN_MIN, DOMAIN_MAX, TITLE and comments).
+		 * @throw ColorLUTError if the content is not a valid 3D .cube LUT.
+		 */
+		[[nodiscard]] static auto from_cube(std::string_view content) -> ColorLUT;
+
+		// @throw ColorLUTError if the file cannot be read or is not a valid 3D .cube LUT.
+		[[nodiscard]] static auto from_cube_file(const std::filesystem::path& path) -> ColorLUT;
+
+		[[nodiscard]] auto size() const noexcept -> size_type;
+
+		[[nodiscard]] auto entries() const noexcept -> std::span<const entry_type>;
+
+		[[nodiscard]] auto apply(const Color& color) const noexcept -> Color;
+
+		// destination[i] = apply(source[i]), `source` and `destination` may be the same buffer
+		auto apply(std::span<const Color> source, std::span<Color> destination) const noexcept -> void;
+
+		// grade the rows [row_begin, row_end) of `surface` in place
+		auto apply(const SurfaceView& surface, std::uint32_t row_begin, std::uint32_t row_end) const noexcept -> void;
+
+		/**
+		 * @brief Split `surface` in tiles of `tile_height` rows and grade them in place.
+		 *
+		 * `dispatch(tile_count, job)` must invoke `job(tile_index)` exactly once for every tile index in [0, tile_count),
+		 * in any order and on any thread, and return once all jobs are done.
+		 */
+		template<typename Dispatch>
+		auto apply(const SurfaceView& surface, const std::uint32_t tile_height, Dispatch&& dispatch) const -> void
+		{
+			const auto height = tile_height == 0 ? surface.height : tile_height;
+			const auto tile_count = height == 0 ? 0 : (surface.height + height - 1) / height;
+
+			const auto job = [this, &surface, height](const std::size_t tile) noexcept -> void
+			{
+				const auto row_begin = static_cast<std::uint32_t>(tile) * height;
+				const auto row_end = row_begin + height < surface.height ? row_begin + height : surface.height;
+
+				apply(surface, row_begin, row_end);
+			};
+
+			std::forward<Dispatch>(dispatch)(static_cast<std::size_t>(tile_count), job);
+		}
+	};
+}
@@ -0,0 +1,180 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <initializer_list>
+#include <optional>
+
+#include <pb/math/position.hpp>
+
+#include <glm/vec2.hpp>
+#include <glm/common.hpp>
+
+namespace pb::math
+{
+	/**
+	 * @brief Axis-aligned bounding box, [min, max] inclusive.
+	 */
+	class AABB
+	{
+	public:
+		using value_type = float;
+
+	private:
+		glm::vec2 min_;
+		glm::vec2 max_;
+
+	public:
+		constexpr AABB(const glm::vec2& min, const glm::vec2& max) noexcept
+			: min_{min},
+			  max_{max} {}
+
+		constexpr AABB() noexcept
+			: AABB{{0, 0}, {0, 0}} {}
+
+		[[nodiscard]] constexpr static auto from_center(const glm::vec2& center, const glm::vec2& half_extent) noexcept -> AABB
+		{
+			return {center - half_extent, center + half_extent};
+		}
+
+		[[nodiscard]] constexpr static auto from_position(const Position& position, const glm::vec2& half_extent) noexcept -> AABB
+		{
+			return from_center(position, half_extent);
+		}
+
+		[[nodiscard]] constexpr static auto from_size(const glm::vec2& position, const glm::vec2& size) noexcept -> AABB
+		{
+			return {position, position + size};
+		}
+
+		[[nodiscard]] constexpr auto min() const noexcept -> const glm::vec2&
+		{
+			return min_;
+		}
+
+		[[nodiscard]] constexpr auto max() const noexcept -> const glm::vec2&
+		{
+			return max_;
+		}
+
+		[[nodiscard]] constexpr auto center() const noexcept -> glm::vec2
+		{
+			return (min_ + max_) * .5f;
+		}
+
+		[[nodiscard]] constexpr auto size() const noexcept -> glm::vec2
+		{
+			return max_ - min_;
+		}
+
+		[[nodiscard]] constexpr auto width() const noexcept -> value_type
+		{
+			return max_.x - min_.x;
+		}
+
+		[[nodiscard]] constexpr auto height() const noexcept -> value_type
+		{
+			return max_.y - min_.y;
+		}
+
+		[[nodiscard]] constexpr auto area() const noexcept -> value_type
+		{
+			return width() * height();
+		}
+
+		[[nodiscard]] constexpr auto perimeter() const noexcept -> value_type
+		{
+			return 2.f * (width() + height());
+		}
+
+		[[nodiscard]] constexpr auto operator==(const AABB& other) const noexcept -> bool = default;
+
+		[[nodiscard]] constexpr auto contains(const glm::vec2& point) const noexcept -> bool
+		{
+			return point.x >= min_.x and point.x <= max_.x and point.y >= min_.y and point.y <= max_.y;
+		}
+
+		[[nodiscard]] constexpr auto contains(const Position& position) const noexcept -> bool
+		{
+			return contains(glm::vec2{position});
+		}
+
+		[[nodiscard]] constexpr auto contains(const AABB& other) const noexcept -> bool
+		{
+			return other.min_.x >= min_.x and other.min_.y >= min_.y and other.max_.x <= max_.x and other.max_.y <= max_.y;
+		}
+
+		[[nodiscard]] constexpr auto overlaps(const AABB& other) const noexcept -> bool
+		{
+			return min_.x <= other.max_.x and other.min_.x <= max_.x and min_.y <= other.max_.y and other.min_.y <= max_.y;
+		}
+
+		[[nodiscard]] constexpr auto merge(const AABB& other) const noexcept -> AABB
+		{
+			return {glm::min(min_, other.min_), glm::max(max_, other.max_)};
+		}
+
+		[[nodiscard]] constexpr auto fatten(const value_type margin) const noexcept -> AABB
+		{
+			return {min_ - glm::vec2{margin, margin}, max_ + glm::vec2{margin, margin}};
+		}
+
+		// extend the box along `displacement`
+		[[nodiscard]] constexpr auto extend(const glm::vec2& displacement) const noexcept -> AABB
+		{
+			return {min_ + glm::min(displacement, glm::vec2{0, 0}), max_ + glm::max(displacement, glm::vec2{0, 0})};
+		}
+
+		/**
+		 * @brief Slab test of the segment `origin + t * direction`, t in [0, max_t].
+		 * @return t of the first intersection (0 if `origin` is inside the box), nullopt if the segment misses the box.
+		 */
+		[[nodiscard]] constexpr auto ray_cast(const glm::vec2& origin, const glm::vec2& direction, const value_type max_t) const noexcept -> std::optional<value_type>
+		{
+			auto t_min = value_type{0};
+			auto t_max = max_t;
+
+			for (const auto axis: {0, 1})
+			{
+				const auto o = axis == 0 ? origin.x : origin.y;
+				const auto d = axis == 0 ? direction.x : direction.y;
+				const auto low = axis == 0 ? min_.x : min_.y;
+				const auto high = axis == 0 ? max_.x : max_.y;
+
+				if (d == 0)
+				{
+					// parallel to the slab
+					if (o < low or o > high)
+					{
+						return std::nullopt;
+					}
+
+					continue;
+				}
+
+				const auto inverse = 1.f / d;
+				auto t1 = (low - o) * inverse;
+				auto t2 = (high - o) * inverse;
+				if (t1 > t2)
+				{
+					const auto t = t1;
+					t1 = t2;
+					t2 = t;
+				}
+
+				t_min = t1 > t_min ? t1 : t_min;
+				t_max = t2 < t_max ? t2 : t_max;
+
+				if (t_min > t_max)
+				{
+					return std::nullopt;
+				}
+			}
+
+			return t_min;
+		}
+	};
+}
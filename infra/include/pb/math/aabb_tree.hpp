@@ -0,0 +1,350 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <pb/math/aabb.hpp>
+
+#include <glm/vec2.hpp>
+
+namespace pb::math
+{
+	/**
+	 * @brief Dynamic bounding volume hierarchy for broad phase collision, ray casts and hit-testing.
+	 *
+	 * Every proxy is a leaf holding a fattened copy of its box, `move_proxy` only touches the tree when the new box leaves the fat box,
+	 * so small per-frame moves cost nothing and the tree is never rebuilt. Leaves are inserted next to the sibling with the lowest
+	 * surface area cost, and the ancestors are refit and rebalanced (AVL-like rotations) on the way up.
+	 *
+	 * All queries are const and do not allocate, any number of threads may query the tree concurrently
+	 * as long as nobody modifies it, e.g. split `proxies()` into chunks and call `query_pairs` for each chunk on a worker thread.
+	 */
+	class AABBTree
+	{
+	public:
+		using value_type = AABB::value_type;
+		using proxy_type = std::uint32_t;
+		using user_data_type = std::uint64_t;
+
+		constexpr static proxy_type null_proxy = std::numeric_limits<proxy_type>::max();
+
+		// extra room around each leaf box
+		constexpr static value_type default_margin = 4.f;
+		// how far ahead of its displacement a moving leaf box is extended
+		constexpr static value_type default_displacement_multiplier = 4.f;
+
+	private:
+		struct node_type
+		{
+			AABB aabb;
+			user_data_type user_data;
+
+			// the next free node if the node is not allocated
+			proxy_type parent;
+			proxy_type child_1;
+			proxy_type child_2;
+
+			// leaf = 0, free = -1
+			std::int32_t height;
+
+			// index in `leaves_`, leaves only
+			std::uint32_t leaf_index;
+
+			[[nodiscard]] constexpr auto is_leaf() const noexcept -> bool
+			{
+				return child_1 == null_proxy;
+			}
+		};
+
+		// depth first traversal stack, only allocates past 64 levels (a balanced tree with 2^32 leaves is ~46 levels deep)
+		class stack_type
+		{
+		public:
+			constexpr static std::size_t inline_capacity = 64;
+
+		private:
+			std::array<proxy_type, inline_capacity> inline_;
+			std::vector<proxy_type> overflow_;
+			std::size_t size_;
+
+		public:
+			explicit stack_type(const proxy_type root) noexcept
+				: inline_{root},
+				  size_{1} {}
+
+			[[nodiscard]] auto empty() const noexcept -> bool
+			{
+				return size_ == 0;
+			}
+
+			auto push(const proxy_type proxy) -> void
+			{
+				if (size_ < inline_capacity)
+				{
+					inline_[size_] = proxy;
+				}
+				else
+				{
+					overflow_.push_back(proxy);
+				}
+
+				size_ += 1;
+			}
+
+			[[nodiscard]] auto pop() noexcept -> proxy_type
+			{
+				size_ -= 1;
+
+				if (size_ < inline_capacity)
+				{
+					return inline_[size_];
+				}
+
+				const auto proxy = overflow_.back();
+				overflow_.pop_back();
+				return proxy;
+			}
+		};
+
+		std::vector<node_type> nodes_;
+		proxy_type root_;
+		proxy_type free_list_;
+
+		std::vector<proxy_type> leaves_;
+
+		value_type margin_;
+		value_type displacement_multiplier_;
+
+		[[nodiscard]] auto allocate_node() -> proxy_type;
+
+		auto free_node(proxy_type node) noexcept -> void;
+
+		// `parent` is an allocated node that becomes the parent of `leaf` and its sibling, null_proxy if (and only if) the tree is empty
+		auto insert_leaf(proxy_type leaf, proxy_type parent) noexcept -> void;
+
+		// @return the former parent of `leaf`, detached from the tree but not freed, null_proxy if `leaf` was the root
+		[[nodiscard]] auto remove_leaf(proxy_type leaf) noexcept -> proxy_type;
+
+		// refit and rebalance from `node` up to the root
+		auto refit(proxy_type node) noexcept -> void;
+
+		// rotate `node` if its children heights differ by more than 1, returns the new root of the subtree
+		[[nodiscard]] auto balance(proxy_type node) noexcept -> proxy_type;
+
+		// function(proxy) for every leaf whose fat box overlaps `aabb`, stops early if function returns false
+		template<typename Function>
+		auto walk(const AABB& aabb, Function& function) const -> bool
+		{
+			if (root_ == null_proxy)
+			{
+				return true;
+			}
+
+			stack_type stack{root_};
+
+			while (not stack.empty())
+			{
+				const auto index = stack.pop();
+
+				const auto& node = nodes_[index];
+				if (not node.aabb.overlaps(aabb))
+				{
+					continue;
+				}
+
+				if (node.is_leaf())
+				{
+					if (not function(index))
+					{
+						return false;
+					}
+				}
+				else
+				{
+					stack.push(node.child_1);
+					stack.push(node.child_2);
+				}
+			}
+
+			return true;
+		}
+
+	public:
+		explicit AABBTree(value_type margin = default_margin, value_type displacement_multiplier = default_displacement_multiplier) noexcept;
+
+		// ============================================================
+		// PROXY
+		// ============================================================
+
+		[[nodiscard]] auto create_proxy(const AABB& aabb, user_data_type user_data) -> proxy_type;
+
+		auto destroy_proxy(proxy_type proxy) noexcept -> void;
+
+		/**
+		 * @brief Update the box of `proxy`, `displacement` is the movement since the last update (used to extend the fat box ahead of the move).
+		 * @return true if the leaf was reinserted (the box left its fat box), false if the tree did not change.
+		 */
+		auto move_proxy(proxy_type proxy, const AABB& aabb, const glm::vec2& displacement = {0, 0}) noexcept -> bool;
+
+		[[nodiscard]] auto user_data_of(proxy_type proxy) const noexcept -> user_data_type;
+
+		// the fattened box stored in the tree
+		[[nodiscard]] auto fat_aabb_of(proxy_type proxy) const noexcept -> const AABB&;
+
+		// all live proxies, in no particular order
+		[[nodiscard]] auto proxies() const noexcept -> std::span<const proxy_type>;
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t;
+
+		[[nodiscard]] auto height() const noexcept -> std::int32_t;
+
+		auto clear() noexcept -> void;
+
+		// ============================================================
+		// QUERY
+		// ============================================================
+
+		/**
+		 * @brief Invoke `function(proxy)` for every proxy whose fat box overlaps `aabb`.
+		 * @note `function` may return bool, false stops the query.
+		 */
+		template<typename Function>
+			requires std::is_invocable_v<Function&, proxy_type>
+		auto query(const AABB& aabb, Function function) const -> void
+		{
+			auto visit = [&function](const proxy_type proxy) -> bool
+			{
+				if constexpr (std::is_same_v<std::invoke_result_t<Function&, proxy_type>, bool>)
+				{
+					return std::invoke(function, proxy);
+				}
+				else
+				{
+					std::invoke(function, proxy);
+					return true;
+				}
+			};
+
+			walk(aabb, visit);
+		}
+
+		/**
+		 * @brief Invoke `function(index, proxy)` for every box in `aabbs` and every proxy overlapping it.
+		 * @note Boxes are queried in order, sort them spatially (e.g. by Morton code) for better cache locality.
+		 */
+		template<typename Function>
+			requires std::is_invocable_v<Function&, std::size_t, proxy_type>
+		auto query(const std::span<const AABB> aabbs, Function function) const -> void
+		{
+			for (std::size_t i = 0; i < aabbs.size(); ++i)
+			{
+				query(
+					aabbs[i],
+					[&function, i](const proxy_type proxy) -> void
+					{
+						std::invoke(function, i, proxy);
+					}
+				);
+			}
+		}
+
+		// invoke `function(proxy)` for every proxy whose fat box contains `point`
+		template<typename Function>
+			requires std::is_invocable_v<Function&, proxy_type>
+		auto query(const glm::vec2& point, Function function) const -> void
+		{
+			query(AABB{point, point}, std::move(function));
+		}
+
+		/**
+		 * @brief Invoke `function(a, b)` with a < b for every pair of overlapping fat boxes where `a` is in `proxies`.
+		 *
+		 * Each unordered pair is reported exactly once across all proxies, so `proxies()` can be split
+		 * into disjoint chunks and every chunk can be processed on its own thread.
+		 */
+		template<typename Function>
+			requires std::is_invocable_v<Function&, proxy_type, proxy_type>
+		auto query_pairs(const std::span<const proxy_type> proxies, Function function) const -> void
+		{
+			for (const auto proxy: proxies)
+			{
+				query(
+					nodes_[proxy].aabb,
+					[&function, proxy](const proxy_type other) -> void
+					{
+						// the other side reports (other, proxy)
+						if (proxy < other)
+						{
+							std::invoke(function, proxy, other);
+						}
+					}
+				);
+			}
+		}
+
+		template<typename Function>
+			requires std::is_invocable_v<Function&, proxy_type, proxy_type>
+		auto query_pairs(Function function) const -> void
+		{
+			query_pairs(proxies(), std::move(function));
+		}
+
+		/**
+		 * @brief Cast the segment `origin + t * direction`, t in [0, max_t] against the fat boxes.
+		 *
+		 * `function(proxy, t)` is invoked for every box hit by the segment, with `t` the entry point, and returns the new `max_t`:
+		 * - return `t` to clip the segment (closest hit only)
+		 * - return `max_t` to continue unchanged (all hits)
+		 * - return 0 to stop
+		 */
+		template<typename Function>
+			requires std::is_invocable_r_v<value_type, Function&, proxy_type, value_type>
+		auto ray_cast(const glm::vec2& origin, const glm::vec2& direction, value_type max_t, Function function) const -> void
+		{
+			if (root_ == null_proxy)
+			{
+				return;
+			}
+
+			stack_type stack{root_};
+
+			while (not stack.empty())
+			{
+				const auto index = stack.pop();
+
+				const auto& node = nodes_[index];
+
+				const auto t = node.aabb.ray_cast(origin, direction, max_t);
+				if (not t.has_value())
+				{
+					continue;
+				}
+
+				if (node.is_leaf())
+				{
+					max_t = std::invoke(function, index, *t);
+					if (max_t <= 0)
+					{
+						return;
+					}
+				}
+				else
+				{
+					stack.push(node.child_1);
+					stack.push(node.child_2);
+				}
+			}
+		}
+	};
+}
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <algorithm>
+#include <concepts>
+#include <cstdint>
 #include <numbers>
 #include <ranges>
+#include <utility>
 
 #include <glm/vec2.hpp>
 #include <glm/common.hpp>
@@ -10,70 +13,228 @@
 
 namespace pb::math
 {
-	class Angle
+	enum class AngleUnit : std::uint8_t
+	{
+		// float, a full turn is 360
+		DEGREES,
+		// float, a full turn is 2 * pi
+		RADIANS,
+		// binary angle measurement, std::uint32_t, a full turn is 2^32 (wraps around for free)
+		BINARY,
+	};
+
+	namespace angle_detail
+	{
+		using scalar_type = float;
+
+		constexpr auto pi = std::numbers::pi_v<scalar_type>;
+
+		template<AngleUnit>
+		struct unit_traits;
+
+		template<>
+		struct unit_traits<AngleUnit::DEGREES>
+		{
+			using value_type = scalar_type;
+
+			constexpr static value_type full_turn = 360.f;
+			constexpr static value_type half_turn = 180.f;
+			constexpr static value_type quarter_turn = 90.f;
+
+			[[nodiscard]] constexpr static auto from_degrees(const scalar_type degrees) noexcept -> value_type
+			{
+				return degrees;
+			}
+
+			[[nodiscard]] constexpr static auto from_radians(const scalar_type radians) noexcept -> value_type
+			{
+				return radians * (180.f / pi);
+			}
+
+			[[nodiscard]] constexpr static auto to_degrees(const value_type value) noexcept -> scalar_type
+			{
+				return value;
+			}
+
+			[[nodiscard]] constexpr static auto to_radians(const value_type value) noexcept -> scalar_type
+			{
+				return value * (pi / 180.f);
+			}
+		};
+
+		template<>
+		struct unit_traits<AngleUnit::RADIANS>
+		{
+			using value_type = scalar_type;
+
+			constexpr static value_type full_turn = pi * 2.f;
+			constexpr static value_type half_turn = pi;
+			constexpr static value_type quarter_turn = pi / 2.f;
+
+			[[nodiscard]] constexpr static auto from_degrees(const scalar_type degrees) noexcept -> value_type
+			{
+				return degrees * (pi / 180.f);
+			}
+
+			[[nodiscard]] constexpr static auto from_radians(const scalar_type radians) noexcept -> value_type
+			{
+				return radians;
+			}
+
+			[[nodiscard]] constexpr static auto to_degrees(const value_type value) noexcept -> scalar_type
+			{
+				return value * (180.f / pi);
+			}
+
+			[[nodiscard]] constexpr static auto to_radians(const value_type value) noexcept -> scalar_type
+			{
+				return value;
+			}
+		};
+
+		template<>
+		struct unit_traits<AngleUnit::BINARY>
+		{
+			using value_type = std::uint32_t;
+
+			constexpr static value_type full_turn = 0;
+			constexpr static value_type half_turn = value_type{1} << 31;
+			constexpr static value_type quarter_turn = value_type{1} << 30;
+
+			// 2^32
+			constexpr static double turn = 4294967296.0;
+
+			// any multiple of a full turn wraps to the same value
+			[[nodiscard]] constexpr static auto from_turns(const double turns) noexcept -> value_type
+			{
+				// 2^52, every double at least this large is a whole number of turns (also rejects inf and nan)
+				constexpr auto exact_integer = 4503599627370496.0;
+				if (not (turns > -exact_integer and turns < exact_integer))
+				{
+					return 0;
+				}
+
+				// drop the whole turns first (exact), the scaled fraction fits in an int64
+				const auto fraction = turns - static_cast<double>(static_cast<std::int64_t>(turns));
+				const auto scaled = fraction * turn;
+				const auto rounded = static_cast<std::int64_t>(scaled >= 0 ? scaled + .5 : scaled - .5);
+				return static_cast<value_type>(static_cast<std::uint64_t>(rounded));
+			}
+
+			[[nodiscard]] constexpr static auto from_degrees(const scalar_type degrees) noexcept -> value_type
+			{
+				return from_turns(static_cast<double>(degrees) / 360.0);
+			}
+
+			[[nodiscard]] constexpr static auto from_radians(const scalar_type radians) noexcept -> value_type
+			{
+				return from_turns(static_cast<double>(radians) / (std::numbers::pi * 2.0));
+			}
+
+			// [0, 360)
+			[[nodiscard]] constexpr static auto to_degrees(const value_type value) noexcept -> scalar_type
+			{
+				return static_cast<scalar_type>(static_cast<double>(value) * (360.0 / turn));
+			}
+
+			// [0, 2 * pi)
+			[[nodiscard]] constexpr static auto to_radians(const value_type value) noexcept -> scalar_type
+			{
+				return static_cast<scalar_type>(static_cast<double>(value) * (std::numbers::pi * 2.0 / turn));
+			}
+		};
+	}
+
+	/**
+	 * @brief An angle stored in `Unit`.
+	 *
+	 * The API is the same for all units, but every value that is not explicitly in degrees/radians
+	 * (`value()`, distances, `move_toward` speed, `within` margin...) is expressed in the unit of the angle:
+	 * - DEGREES: `Angle`, the default
+	 * - RADIANS: `sin`/`cos`/`rotate_point`/`slerp` and `from_position` do not convert at all
+	 * - BINARY: the value is always normalized, `+`/`-` wrap around without `glm::mod`
+	 */
+	template<AngleUnit Unit>
+	class BasicAngle
 	{
 	public:
-		using value_type = float;
+		using traits_type = angle_detail::unit_traits<Unit>;
+
+		using value_type = typename traits_type::value_type;
+		using scalar_type = angle_detail::scalar_type;
+
+		constexpr static auto unit = Unit;
 
-		constexpr static auto radians_to_degrees = 180.f / std::numbers::pi_v<value_type>;
-		constexpr static auto degrees_to_radians = std::numbers::pi_v<value_type> / 180.f;
+		constexpr static auto radians_to_degrees = 180.f / std::numbers::pi_v<scalar_type>;
+		constexpr static auto degrees_to_radians = std::numbers::pi_v<scalar_type> / 180.f;
 
 	private:
-		value_type degrees_;
+		constexpr static auto is_binary = Unit == AngleUnit::BINARY;
 
-		constexpr explicit Angle(const value_type degrees) noexcept
-			: degrees_(degrees) {}
+		value_type value_;
+
+		constexpr explicit BasicAngle(const value_type value) noexcept
+			: value_(value) {}
 
 	public:
 		// ============================================================
 		// CTOR
 		// ============================================================
 
-		[[nodiscard]] constexpr static auto from_degrees(const value_type degrees) noexcept -> Angle
+		// the raw value in `Unit`
+		[[nodiscard]] constexpr static auto from_value(const value_type value) noexcept -> BasicAngle
+		{
+			return BasicAngle{value};
+		}
+
+		[[nodiscard]] constexpr static auto from_degrees(const scalar_type degrees) noexcept -> BasicAngle
 		{
-			return Angle{degrees};
+			return BasicAngle{traits_type::from_degrees(degrees)};
 		}
 
-		[[nodiscard]] constexpr static auto from_radians(const value_type radians) noexcept -> Angle
+		[[nodiscard]] constexpr static auto from_radians(const scalar_type radians) noexcept -> BasicAngle
 		{
-			return Angle{radians * radians_to_degrees};
+			return BasicAngle{traits_type::from_radians(radians)};
 		}
 
-		[[nodiscard]] /*constexpr*/ static auto from_position(const glm::vec2& from, const glm::vec2& to) noexcept -> Angle
+		[[nodiscard]] /*constexpr*/ static auto from_position(const glm::vec2& from, const glm::vec2& to) noexcept -> BasicAngle
 		{
 			const auto delta = to - from;
 			const auto radians = glm::atan(delta.y, delta.x);
 
-			auto degrees = from_radians(radians).to_degrees();
-			if (degrees < 0)
+			auto value = traits_type::from_radians(radians);
+			if constexpr (not is_binary)
 			{
-				degrees += 360.f;
+				if (value < 0)
+				{
+					value += traits_type::full_turn;
+				}
 			}
 
-			return from_degrees(degrees);
+			return BasicAngle{value};
 		}
 
-		[[nodiscard]] /*constexpr*/ static auto from_position(const value_type x1, const value_type y1, const value_type x2, const value_type y2) noexcept -> Angle
+		[[nodiscard]] /*constexpr*/ static auto from_position(const scalar_type x1, const scalar_type y1, const scalar_type x2, const scalar_type y2) noexcept -> BasicAngle
 		{
 			return from_position({x1, y1}, {x2, y2});
 		}
 
-		[[nodiscard]] /*constexpr*/ static auto from_position(const glm::vec2& to) noexcept -> Angle
+		[[nodiscard]] /*constexpr*/ static auto from_position(const glm::vec2& to) noexcept -> BasicAngle
 		{
 			return from_position({0, 0}, to);
 		}
 
-		[[nodiscard]] /*constexpr*/ static auto from_position(const value_type x, const value_type y) noexcept -> Angle
+		[[nodiscard]] /*constexpr*/ static auto from_position(const scalar_type x, const scalar_type y) noexcept -> BasicAngle
 		{
 			return from_position({0, 0}, {x, y});
 		}
 
-		[[nodiscard]] /*constexpr*/ static auto from_direction(const glm::vec2& direction) noexcept -> Angle
+		[[nodiscard]] /*constexpr*/ static auto from_direction(const glm::vec2& direction) noexcept -> BasicAngle
 		{
 			return from_radians(glm::atan(direction.x, direction.y));
 		}
 
-		[[nodiscard]] /*constexpr*/ static auto from_direction(const value_type x, const value_type y) noexcept -> Angle
+		[[nodiscard]] /*constexpr*/ static auto from_direction(const scalar_type x, const scalar_type y) noexcept -> BasicAngle
 		{
 			return from_direction({x, y});
 		}
@@ -82,100 +243,152 @@ namespace pb::math
 		// CONSTANT
 		// ============================================================
 
-		[[nodiscard]] constexpr static auto zero() noexcept -> Angle
+		[[nodiscard]] constexpr static auto zero() noexcept -> BasicAngle
 		{
-			return from_degrees(0.f);
+			return BasicAngle{value_type{0}};
 		}
 
-		[[nodiscard]] constexpr static auto quarter() noexcept -> Angle
+		[[nodiscard]] constexpr static auto quarter() noexcept -> BasicAngle
 		{
-			return from_degrees(90.f);
+			return BasicAngle{traits_type::quarter_turn};
 		}
 
-		[[nodiscard]] constexpr static auto half() noexcept -> Angle
+		[[nodiscard]] constexpr static auto half() noexcept -> BasicAngle
 		{
-			return from_degrees(180.f);
+			return BasicAngle{traits_type::half_turn};
 		}
 
-		[[nodiscard]] constexpr static auto full() noexcept -> Angle
+		// NOTE: same as `zero()` for BINARY
+		[[nodiscard]] constexpr static auto full() noexcept -> BasicAngle
 		{
-			return from_degrees(360.f);
+			return BasicAngle{traits_type::full_turn};
 		}
 
-		[[nodiscard]] constexpr static auto up() noexcept -> Angle
+		[[nodiscard]] constexpr static auto up() noexcept -> BasicAngle
 		{
 			return zero();
 		}
 
-		[[nodiscard]] constexpr static auto right() noexcept -> Angle
+		[[nodiscard]] constexpr static auto right() noexcept -> BasicAngle
 		{
 			return quarter();
 		}
 
-		[[nodiscard]] constexpr static auto down() noexcept -> Angle
+		[[nodiscard]] constexpr static auto down() noexcept -> BasicAngle
 		{
 			return half();
 		}
 
-		[[nodiscard]] constexpr static auto left() noexcept -> Angle
+		[[nodiscard]] constexpr static auto left() noexcept -> BasicAngle
 		{
-			return from_degrees(270.f);
+			return BasicAngle{static_cast<value_type>(traits_type::half_turn + traits_type::quarter_turn)};
 		}
 
 		// ============================================================
 		// OPERATION
 		// ============================================================
 
-		[[nodiscard]] constexpr auto operator<=>(const Angle& other) const noexcept -> std::partial_ordering = default;
+		[[nodiscard]] constexpr auto operator<=>(const BasicAngle& other) const noexcept -> std::partial_ordering = default;
 
-		[[nodiscard]] constexpr auto operator+(const Angle& other) const noexcept -> Angle
+		[[nodiscard]] constexpr auto operator+(const BasicAngle& other) const noexcept -> BasicAngle
 		{
-			return from_degrees(degrees_ + other.degrees_);
+			return BasicAngle{static_cast<value_type>(value_ + other.value_)};
 		}
 
-		[[nodiscard]] constexpr auto operator-(const Angle& other) const noexcept -> Angle
+		[[nodiscard]] constexpr auto operator-(const BasicAngle& other) const noexcept -> BasicAngle
 		{
-			return from_degrees(degrees_ - other.degrees_);
+			return BasicAngle{static_cast<value_type>(value_ - other.value_)};
 		}
 
-		[[nodiscard]] constexpr auto operator*(const value_type scalar) const noexcept -> Angle
+		[[nodiscard]] constexpr auto operator*(const scalar_type scalar) const noexcept -> BasicAngle
 		{
-			return from_degrees(degrees_ * scalar);
+			if constexpr (is_binary)
+			{
+				return BasicAngle{traits_type::from_turns(static_cast<double>(value_) / traits_type::turn * scalar)};
+			}
+			else
+			{
+				return BasicAngle{value_ * scalar};
+			}
 		}
 
-		[[nodiscard]] constexpr auto operator/(const value_type scalar) const noexcept -> Angle
+		[[nodiscard]] constexpr auto operator/(const scalar_type scalar) const noexcept -> BasicAngle
 		{
-			return from_degrees(degrees_ / scalar);
+			if constexpr (is_binary)
+			{
+				return BasicAngle{traits_type::from_turns(static_cast<double>(value_) / traits_type::turn / scalar)};
+			}
+			else
+			{
+				return BasicAngle{value_ / scalar};
+			}
 		}
 
 		// ============================================================
 		// CONVERSION
 		// ============================================================
 
-		[[nodiscard]] constexpr auto to_degrees() const noexcept -> value_type
+		[[nodiscard]] constexpr auto value() const noexcept -> value_type
 		{
-			return degrees_;
+			return value_;
 		}
 
-		[[nodiscard]] constexpr auto to_radians() const noexcept -> value_type
+		[[nodiscard]] constexpr auto to_degrees() const noexcept -> scalar_type
 		{
-			return degrees_ * degrees_to_radians;
+			return traits_type::to_degrees(value_);
 		}
 
-		[[nodiscard]] constexpr auto to_normalized() const noexcept -> Angle
+		[[nodiscard]] constexpr auto to_radians() const noexcept -> scalar_type
 		{
-			return from_degrees(glm::mod(degrees_, 360.f));
+			return traits_type::to_radians(value_);
 		}
 
-		[[nodiscard]] constexpr auto to_signed_normalized() const noexcept -> Angle
+		template<AngleUnit To>
+		[[nodiscard]] constexpr auto to() const noexcept -> BasicAngle<To>
 		{
-			auto normalized = to_normalized().to_degrees();
-			if (normalized > 180.0f)
+			if constexpr (To == Unit)
+			{
+				return *this;
+			}
+			else if constexpr (To == AngleUnit::RADIANS or Unit == AngleUnit::RADIANS)
+			{
+				return BasicAngle<To>::from_radians(to_radians());
+			}
+			else
 			{
-				normalized -= 360.0f;
+				return BasicAngle<To>::from_degrees(to_degrees());
 			}
+		}
 
-			return from_degrees(normalized);
+		[[nodiscard]] constexpr auto to_normalized() const noexcept -> BasicAngle
+		{
+			if constexpr (is_binary)
+			{
+				return *this;
+			}
+			else
+			{
+				return BasicAngle{glm::mod(value_, traits_type::full_turn)};
+			}
+		}
+
+		// NOTE: BINARY angles can only be reinterpreted as signed, see `value()`
+		[[nodiscard]] constexpr auto to_signed_normalized() const noexcept -> BasicAngle
+		{
+			if constexpr (is_binary)
+			{
+				return *this;
+			}
+			else
+			{
+				auto normalized = to_normalized().value();
+				if (normalized > traits_type::half_turn)
+				{
+					normalized -= traits_type::full_turn;
+				}
+
+				return BasicAngle{normalized};
+			}
 		}
 
 		// ============================================================
@@ -184,41 +397,56 @@ namespace pb::math
 
 		[[nodiscard]] constexpr auto is_acute() const noexcept -> bool
 		{
-			return to_normalized().to_degrees() < 90.0f;
+			return to_normalized().value() < traits_type::quarter_turn;
 		}
 
 		[[nodiscard]] constexpr auto is_obtuse() const noexcept -> bool
 		{
-			const auto degrees = to_normalized().to_degrees();
-			return degrees > 90.0f and degrees < 180.0f;
+			const auto value = to_normalized().value();
+			return value > traits_type::quarter_turn and value < traits_type::half_turn;
 		}
 
 		[[nodiscard]] constexpr auto is_reflex() const noexcept -> bool
 		{
-			return to_normalized().to_degrees() > 180.0f;
+			return to_normalized().value() > traits_type::half_turn;
 		}
 
 		// ============================================================
 		// DISTANCE
 		// ============================================================
 
-		[[nodiscard]] constexpr auto clockwise_distance(const Angle to) const noexcept -> value_type
+		[[nodiscard]] constexpr auto clockwise_distance(const BasicAngle to) const noexcept -> value_type
 		{
-			return glm::abs(to.to_degrees() - to_degrees());
+			if constexpr (is_binary)
+			{
+				return static_cast<value_type>(to.value_ - value_);
+			}
+			else
+			{
+				return glm::abs(to.value_ - value_);
+			}
 		}
 
-		[[nodiscard]] constexpr auto counter_clockwise_distance(const Angle to) const noexcept -> value_type
+		[[nodiscard]] constexpr auto counter_clockwise_distance(const BasicAngle to) const noexcept -> value_type
 		{
-			return 360.f - clockwise_distance(to);
+			return static_cast<value_type>(traits_type::full_turn - clockwise_distance(to));
 		}
 
-		[[nodiscard]] constexpr auto shortest_distance(const Angle to) const noexcept -> value_type
+		[[nodiscard]] constexpr auto shortest_distance(const BasicAngle to) const noexcept -> value_type
 		{
-			const auto diff = glm::abs(to_degrees() - to.to_degrees());
-			return glm::min(diff, 360.0f - diff);
+			if constexpr (is_binary)
+			{
+				const auto diff = static_cast<value_type>(value_ - to.value_);
+				return std::ranges::min(diff, static_cast<value_type>(0 - diff));
+			}
+			else
+			{
+				const auto diff = glm::abs(value_ - to.value_);
+				return glm::min(diff, traits_type::full_turn - diff);
+			}
 		}
 
-		[[nodiscard]] constexpr auto within(const Angle other, const value_type margin) const noexcept -> bool
+		[[nodiscard]] constexpr auto within(const BasicAngle other, const value_type margin) const noexcept -> bool
 		{
 			return shortest_distance(other) <= margin;
 		}
@@ -228,7 +456,7 @@ namespace pb::math
 #undef near
 #endif
 
-		[[nodiscard]] constexpr auto near(const Angle other, const value_type range) const noexcept -> bool
+		[[nodiscard]] constexpr auto near(const BasicAngle other, const value_type range) const noexcept -> bool
 		{
 			return shortest_distance(other) < range;
 		}
@@ -237,7 +465,22 @@ namespace pb::math
 #pragma pop_macro("near")
 #endif
 
-		[[nodiscard]] constexpr auto move_toward(const Angle target, const value_type speed) const noexcept -> Angle
+	private:
+		// true if the shortest way to `target` is clockwise
+		[[nodiscard]] constexpr auto is_clockwise_toward(const BasicAngle target) const noexcept -> bool
+		{
+			if constexpr (is_binary)
+			{
+				return static_cast<std::int32_t>(target.value_ - value_) >= 0;
+			}
+			else
+			{
+				return glm::mod(target.value_ - value_ + traits_type::half_turn, traits_type::full_turn) - traits_type::half_turn >= 0;
+			}
+		}
+
+	public:
+		[[nodiscard]] constexpr auto move_toward(const BasicAngle target, const value_type speed) const noexcept -> BasicAngle
 		{
 			if (const auto distance = shortest_distance(target);
 				distance < speed)
@@ -245,79 +488,129 @@ namespace pb::math
 				return target;
 			}
 
-			if (const auto diff = glm::mod(target.to_degrees() - to_degrees() + 180.f, 360.f) - 180.f;
-				diff >= 0)
+			if (is_clockwise_toward(target))
 			{
-				return from_degrees(to_degrees() + speed);
+				return BasicAngle{static_cast<value_type>(value_ + speed)};
 			}
 
-			return from_degrees(to_degrees() - speed);
+			return BasicAngle{static_cast<value_type>(value_ - speed)};
 		}
 
 		// ============================================================
 		// VALUE
 		// ============================================================
 
-		[[nodiscard]] constexpr auto clamp(const Angle dest, const value_type range) const noexcept -> Angle
+		[[nodiscard]] constexpr auto clamp(const BasicAngle dest, const value_type range) const noexcept -> BasicAngle
 		{
 			const auto distance = shortest_distance(dest);
-			return distance <= range ? *this : move_toward(dest, distance - range);
+			return distance <= range ? *this : move_toward(dest, static_cast<value_type>(distance - range));
 		}
 
 		// ReSharper disable once IdentifierTypo
-		[[nodiscard]] constexpr auto lerp(const Angle dest, const value_type t) const noexcept -> Angle
+		[[nodiscard]] constexpr auto lerp(const BasicAngle dest, const scalar_type t) const noexcept -> BasicAngle
 		{
-			const auto shortest = shortest_distance(dest);
-			const auto direction = glm::mod(dest.to_degrees() - to_degrees() + 180.f, 360.f) - 180.f >= 0 ? 1.f : -1.f;
+			if constexpr (is_binary)
+			{
+				// the signed difference is always the shortest one
+				const auto diff = static_cast<std::int32_t>(dest.value_ - value_);
+				return BasicAngle{static_cast<value_type>(value_ + static_cast<value_type>(static_cast<std::int64_t>(static_cast<double>(diff) * t)))};
+			}
+			else
+			{
+				const auto shortest = shortest_distance(dest);
+				const auto direction = is_clockwise_toward(dest) ? 1.f : -1.f;
 
-			return from_degrees(to_degrees() + direction * shortest * t);
+				return BasicAngle{value_ + direction * shortest * t};
+			}
 		}
 
 		// ReSharper disable once IdentifierTypo
-		[[nodiscard]] constexpr auto slerp(const Angle dest, const value_type t) const noexcept -> Angle
+		[[nodiscard]] constexpr auto slerp(const BasicAngle dest, const scalar_type t) const noexcept -> BasicAngle
 		{
-			const auto from = to_radians();
-			const auto to = dest.to_radians();
-
-			const auto diff = to - from;
-			const auto diff_abs = glm::abs(diff);
-
-			const auto shortest =
-					diff_abs < std::numbers::pi_v<value_type>
-						? diff
-						: (
-							diff > 0
-								? diff - std::numbers::pi_v<value_type> * 2.f
-								: diff + std::numbers::pi_v<value_type> * 2.f
-						);
-
-			return from_radians(from + shortest * t);
+			if constexpr (is_binary)
+			{
+				return lerp(dest, t);
+			}
+			else
+			{
+				const auto diff = dest.value_ - value_;
+				const auto diff_abs = glm::abs(diff);
+
+				const auto shortest =
+						diff_abs < traits_type::half_turn
+							? diff
+							: (
+								diff > 0
+									? diff - traits_type::full_turn
+									: diff + traits_type::full_turn
+							);
+
+				return BasicAngle{value_ + shortest * t};
+			}
 		}
 
 		// ============================================================
 		// COORDINATE
 		// ============================================================
 
-		[[nodiscard]] /*constexpr*/ auto sin() const noexcept -> value_type
+		[[nodiscard]] /*constexpr*/ auto sin() const noexcept -> scalar_type
 		{
 			return glm::sin(to_radians());
 		}
 
-		[[nodiscard]] /*constexpr*/ auto cos() const noexcept -> value_type
+		[[nodiscard]] /*constexpr*/ auto cos() const noexcept -> scalar_type
 		{
 			return glm::cos(to_radians());
 		}
 
-		[[nodiscard]] /*constexpr*/ auto to_cartesian(const value_type length = 1.f) const noexcept -> glm::vec2
+		// {sin, cos}
+		[[nodiscard]] /*constexpr*/ auto sincos() const noexcept -> std::pair<scalar_type, scalar_type>
+		{
+			// computed once, compilers merge the two calls into a single sincos
+			const auto radians = to_radians();
+			return {glm::sin(radians), glm::cos(radians)};
+		}
+
+		/**
+		 * @brief {sin, cos} from a lookup table instead of `glm::sin`/`glm::cos`.
+		 * @note See `SinCosTable` for the accuracy of each resolution.
+		 */
+		template<typename Table>
+			requires requires(const Table& table, const BasicAngle& angle) { { table.sincos(angle) } -> std::same_as<std::pair<scalar_type, scalar_type>>; }
+		[[nodiscard]] constexpr auto sincos(const Table& table) const noexcept -> std::pair<scalar_type, scalar_type>
+		{
+			return table.sincos(*this);
+		}
+
+		[[nodiscard]] /*constexpr*/ auto to_cartesian(const scalar_type length = 1.f) const noexcept -> glm::vec2
 		{
-			return {length * sin(), length * cos()};
+			const auto [sin, cos] = sincos();
+			return {length * sin, length * cos};
+		}
+
+		template<typename Table>
+		[[nodiscard]] constexpr auto to_cartesian(const Table& table, const scalar_type length = 1.f) const noexcept -> glm::vec2 //
+			requires requires(const Table& t, const BasicAngle& angle) { angle.sincos(t); }
+		{
+			const auto [sin, cos] = sincos(table);
+			return {length * sin, length * cos};
 		}
 
 		[[nodiscard]] /*constexpr*/ auto rotate_point(const glm::vec2& point) const noexcept -> glm::vec2
 		{
-			const auto radians = to_radians();
-			const auto cos = glm::cos(radians);
-			const auto sin = glm::sin(radians);
+			const auto [sin, cos] = sincos();
+
+			const auto x = point.x * cos - point.y * sin;
+			const auto y = point.x * sin + point.y * cos;
+
+			return {x, y};
+		}
+
+		template<typename Table>
+		[[nodiscard]] constexpr auto rotate_point(const glm::vec2& point, const Table& table) const noexcept -> glm::vec2 //
+			requires requires(const Table& t, const BasicAngle& angle) { angle.sincos(t); }
+		{
+			const auto [sin, cos] = sincos(table);
 
 			const auto x = point.x * cos - point.y * sin;
 			const auto y = point.x * sin + point.y * cos;
@@ -331,27 +624,21 @@ namespace pb::math
 
 	private:
 		template<typename Collector>
-		[[nodiscard]] consteval static auto is_valid_collector([[maybe_unused]] Collector&& collector) noexcept -> bool
-		{
-			return requires { collector(value_type{}, value_type{}); };
-		}
+		constexpr static auto is_valid_collector = requires(Collector& collector) { collector(scalar_type{}, scalar_type{}); };
 
 		template<typename Container>
-		[[nodiscard]] consteval static auto is_valid_container([[maybe_unused]] Container& container) noexcept -> bool
-		{
-			return
-					requires { container.emplace_back({value_type{}, value_type{}}); } or
-					requires { container.push_back({value_type{}, value_type{}}); } or
-					requires { container.emplace({value_type{}, value_type{}}); } or
-					requires { container.push({value_type{}, value_type{}}); } or
-					requires { container.append({value_type{}, value_type{}}); } or
-					requires { container.set({value_type{}, value_type{}}); };
-		}
+		constexpr static auto is_valid_container =
+				requires(Container& container) { container.emplace_back({scalar_type{}, scalar_type{}}); } or
+				requires(Container& container) { container.push_back({scalar_type{}, scalar_type{}}); } or
+				requires(Container& container) { container.emplace({scalar_type{}, scalar_type{}}); } or
+				requires(Container& container) { container.push({scalar_type{}, scalar_type{}}); } or
+				requires(Container& container) { container.append({scalar_type{}, scalar_type{}}); } or
+				requires(Container& container) { container.set({scalar_type{}, scalar_type{}}); };
 
 		template<typename Container>
 		[[nodiscard]] constexpr static auto make_collector(Container& container) noexcept -> auto
 		{
-			return [&container](const value_type x, const value_type y) noexcept -> void
+			return [&container](const scalar_type x, const scalar_type y) noexcept -> void
 			{
 				if constexpr (requires { container.emplace_back({x, y}); })
 				{
@@ -382,39 +669,44 @@ namespace pb::math
 
 	public:
 		template<typename Collector>
-		constexpr static auto circle_vector(const std::size_t points, const value_type length, const value_type offset, Collector&& collector) noexcept -> void //
-			requires(Angle::is_valid_collector(collector))
+		constexpr static auto circle_vector(const std::size_t points, const scalar_type length, const scalar_type offset, Collector&& collector) noexcept -> void //
+			requires(BasicAngle::is_valid_collector<std::remove_reference_t<Collector>>)
 		{
 			std::ranges::for_each(
-				std::views::iota(points),
+				std::views::iota(std::size_t{0}, points),
 				[points, length, offset, c = std::forward<Collector>(collector)](const auto index) noexcept -> void
 				{
-					const auto angle = offset + from_degrees(static_cast<value_type>(index) * (360.f / static_cast<value_type>(points)));
-					c(angle.to_cartesian_x(length), angle.to_cartesian_y(length));
+					const auto angle = from_degrees(offset) + from_degrees(static_cast<scalar_type>(index) * (360.f / static_cast<scalar_type>(points)));
+					const auto cartesian = angle.to_cartesian(length);
+					c(cartesian.x, cartesian.y);
 				}
 			);
 		}
 
 		template<typename Collector>
-		constexpr static auto circle_vector(const std::size_t points, const value_type length, Collector&& collector) noexcept -> void //
-			requires(Angle::is_valid_collector(collector))
+		constexpr static auto circle_vector(const std::size_t points, const scalar_type length, Collector&& collector) noexcept -> void //
+			requires(BasicAngle::is_valid_collector<std::remove_reference_t<Collector>>)
 		{
-			return Angle::circle_vector(points, length, value_type{0}, std::forward<Collector>(collector));
+			return BasicAngle::circle_vector(points, length, scalar_type{0}, std::forward<Collector>(collector));
 		}
 
 		template<typename Container>
-		constexpr static auto circle_vector(const std::size_t points, const value_type length, const value_type offset, Container& container) noexcept -> void //
-			requires(Angle::is_valid_container(container))
+		constexpr static auto circle_vector(const std::size_t points, const scalar_type length, const scalar_type offset, Container& container) noexcept -> void //
+			requires(BasicAngle::is_valid_container<Container>)
 		{
-			auto insertor = Angle::make_collector(container);
-			return Angle::circle_vector(points, length, offset, insertor);
+			auto insertor = BasicAngle::make_collector(container);
+			return BasicAngle::circle_vector(points, length, offset, insertor);
 		}
 
 		template<typename Container>
-		constexpr static auto circle_vector(const std::size_t points, const value_type length, Container& container) noexcept -> void //
-			requires(Angle::is_valid_container(container))
+		constexpr static auto circle_vector(const std::size_t points, const scalar_type length, Container& container) noexcept -> void //
+			requires(BasicAngle::is_valid_container<Container>)
 		{
-			return Angle::circle_vector(points, length, value_type{0}, container);
+			return BasicAngle::circle_vector(points, length, scalar_type{0}, container);
 		}
 	};
+
+	using Angle = BasicAngle<AngleUnit::DEGREES>;
+	using RadiansAngle = BasicAngle<AngleUnit::RADIANS>;
+	using BinaryAngle = BasicAngle<AngleUnit::BINARY>;
 }
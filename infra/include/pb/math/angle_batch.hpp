@@ -0,0 +1,204 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <span>
+#include <utility>
+
+#include <pb/math/angle.hpp>
+
+#include <glm/vec2.hpp>
+
+namespace pb::math
+{
+	namespace angle_batch_detail
+	{
+		using value_type = Angle::value_type;
+
+		constexpr auto pi = std::numbers::pi_v<value_type>;
+		constexpr auto half_pi = pi / 2.f;
+
+		// Taylor series up to x^9, |error| < 2e-9 for |x| <= pi/4
+		[[nodiscard]] constexpr auto sin_polynomial(const value_type x) noexcept -> value_type
+		{
+			const auto x2 = x * x;
+			return x + x * x2 * (-1.f / 6 + x2 * (1.f / 120 + x2 * (-1.f / 5040 + x2 * (1.f / 362880))));
+		}
+
+		// Taylor series up to x^8, |error| < 3e-8 for |x| <= pi/4
+		[[nodiscard]] constexpr auto cos_polynomial(const value_type x) noexcept -> value_type
+		{
+			const auto x2 = x * x;
+			return 1.f + x2 * (-1.f / 2 + x2 * (1.f / 24 + x2 * (-1.f / 720 + x2 * (1.f / 40320))));
+		}
+
+		// Abramowitz & Stegun 4.4.49, |error| <= 2e-8 for 0 <= x <= 1
+		[[nodiscard]] constexpr auto atan_polynomial(const value_type x) noexcept -> value_type
+		{
+			const auto x2 = x * x;
+			return x * (
+				1.f + x2 * (
+					-0.3333314528f + x2 * (
+						0.1999355085f + x2 * (
+							-0.1420889944f + x2 * (
+								0.1065626393f + x2 * (
+									-0.0752896400f + x2 * (
+										0.0429096138f + x2 * (
+											-0.0161657367f + x2 * 0.0028662257f
+										)
+									)
+								)
+							)
+						)
+					)
+				)
+			);
+		}
+
+		/**
+		 * @brief {sin, cos} of an angle in degrees.
+		 *
+		 * The angle is reduced to [-45, 45] degrees around the nearest multiple of 90 degrees in the degree domain
+		 * (exact for any angle a float can represent to better than a degree), then evaluated with `sin_polynomial` / `cos_polynomial`.
+		 * The quadrant only swaps and negates the two results, so `sin^2 + cos^2` stays within a few ulp of 1.
+		 */
+		[[nodiscard]] constexpr auto sincos(const value_type degrees) noexcept -> std::pair<value_type, value_type>
+		{
+			const auto quadrant = static_cast<std::int32_t>(degrees * (1.f / 90.f) + (degrees >= 0 ? .5f : -.5f));
+			const auto x = (degrees - static_cast<value_type>(quadrant) * 90.f) * Angle::degrees_to_radians;
+
+			const auto s = sin_polynomial(x);
+			const auto c = cos_polynomial(x);
+
+			switch (quadrant & 3)
+			{
+				case 0: { return {s, c}; }
+				case 1: { return {c, -s}; }
+				case 2: { return {-s, -c}; }
+				default: { return {-c, s}; }
+			}
+		}
+
+		// atan2(y, x) in radians, [-pi, pi], 0 if both are zero
+		[[nodiscard]] constexpr auto atan2(const value_type y, const value_type x) noexcept -> value_type
+		{
+			const auto abs_x = x < 0 ? -x : x;
+			const auto abs_y = y < 0 ? -y : y;
+
+			const auto max = abs_x < abs_y ? abs_y : abs_x;
+			const auto min = abs_x < abs_y ? abs_x : abs_y;
+
+			auto radians = max == 0 ? 0.f : atan_polynomial(min / max);
+
+			if (abs_y > abs_x)
+			{
+				radians = half_pi - radians;
+			}
+			if (x < 0)
+			{
+				radians = pi - radians;
+			}
+			if (y < 0)
+			{
+				radians = -radians;
+			}
+
+			return radians;
+		}
+	}
+
+	/**
+	 * @brief Non-owning view over a contiguous array of `Angle`, applies the scalar `Angle` operations to all of them at SIMD width.
+	 *
+	 * sin/cos/atan2 are polynomial approximations (see `angle_batch_detail`) instead of `glm::sin`/`glm::cos`/`glm::atan`:
+	 * - sin/cos: |error| <= 1e-7
+	 * - atan2: |error| <= 3e-7 radians
+	 * Every element gets the same result regardless of its position in the span (the SIMD body and the scalar tail evaluate the same polynomials).
+	 *
+	 * Spans passed along with the batch must hold at least `size()` elements, only the first `size()` are used.
+	 * Input and output spans may be the same span, but must not otherwise overlap.
+	 */
+	class AngleBatch
+	{
+	public:
+		using value_type = Angle::value_type;
+		using size_type = std::size_t;
+
+	private:
+		std::span<Angle> angles_;
+
+	public:
+		constexpr explicit AngleBatch(const std::span<Angle> angles) noexcept
+			: angles_{angles} {}
+
+		[[nodiscard]] constexpr auto size() const noexcept -> size_type
+		{
+			return angles_.size();
+		}
+
+		[[nodiscard]] constexpr auto angles() const noexcept -> std::span<Angle>
+		{
+			return angles_;
+		}
+
+		// ============================================================
+		// CTOR
+		// ============================================================
+
+		// angles[i] = Angle::from_position(from[i], to[i])
+		auto from_position(std::span<const glm::vec2> from, std::span<const glm::vec2> to) const noexcept -> void;
+
+		// angles[i] = Angle::from_position(to[i])
+		auto from_position(std::span<const glm::vec2> to) const noexcept -> void;
+
+		// angles[i] = Angle::from_direction(direction[i])
+		auto from_direction(std::span<const glm::vec2> direction) const noexcept -> void;
+
+		// ============================================================
+		// CONVERSION
+		// ============================================================
+
+		// angles[i] = angles[i].to_normalized()
+		auto normalize() const noexcept -> void;
+
+		// ============================================================
+		// VALUE
+		// ============================================================
+
+		// angles[i] = angles[i].move_toward(target[i], speed)
+		auto move_toward(std::span<const Angle> target, value_type speed) const noexcept -> void;
+
+		// angles[i] = angles[i].lerp(dest[i], t)
+		// ReSharper disable once IdentifierTypo
+		auto lerp(std::span<const Angle> dest, value_type t) const noexcept -> void;
+
+		// angles[i] = angles[i].slerp(dest[i], t)
+		// ReSharper disable once IdentifierTypo
+		auto slerp(std::span<const Angle> dest, value_type t) const noexcept -> void;
+
+		// ============================================================
+		// COORDINATE
+		// ============================================================
+
+		// out[i] = angles[i].sin()
+		auto sin(std::span<value_type> out) const noexcept -> void;
+
+		// out[i] = angles[i].cos()
+		auto cos(std::span<value_type> out) const noexcept -> void;
+
+		// out_sin[i] = angles[i].sin(), out_cos[i] = angles[i].cos()
+		auto sincos(std::span<value_type> out_sin, std::span<value_type> out_cos) const noexcept -> void;
+
+		// out[i] = angles[i].to_cartesian(length)
+		auto to_cartesian(std::span<glm::vec2> out, value_type length = 1.f) const noexcept -> void;
+
+		// out[i] = angles[i].rotate_point(point[i])
+		auto rotate_point(std::span<const glm::vec2> point, std::span<glm::vec2> out) const noexcept -> void;
+	};
+}
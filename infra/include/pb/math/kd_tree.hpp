@@ -0,0 +1,131 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include <pb/math/position.hpp>
+
+namespace pb::math
+{
+	/**
+	 * @brief Static 2D k-d tree over a set of `Position`s, answers (batched) k-nearest-neighbour queries.
+	 *
+	 * The tree is built once in O(n log n) (median splits along the wider axis) and keeps its own copy of the points,
+	 * reordered so that every leaf bucket is a contiguous run of x/y floats. Rebuild it whenever the points move,
+	 * building is cheap compared to n queries.
+	 *
+	 * Batched queries are processed in Morton order of the query points: consecutive queries walk almost the same
+	 * path down the tree and hit the same buckets, which stay in cache.
+	 *
+	 * @code
+	 * const KDTree tree{positions};
+	 *
+	 * // k + 1, every point finds itself first
+	 * std::vector<KDTree::neighbor_type> neighbors(positions.size() * (k + 1));
+	 * tree.nearest(positions, k + 1, neighbors);
+	 *
+	 * // or split the work across worker threads
+	 * const auto order = KDTree::morton_order(positions);
+	 * // each worker: tree.nearest(positions, std::span{order}.subspan(begin, count), k + 1, neighbors);
+	 * @endcode
+	 */
+	class KDTree
+	{
+	public:
+		using value_type = Position::value_type;
+		using size_type = std::uint32_t;
+
+		constexpr static size_type invalid_index = std::numeric_limits<size_type>::max();
+
+		// max number of points in a leaf
+		constexpr static size_type bucket_size = 8;
+
+		struct neighbor_type
+		{
+			// index in the points the tree was built from, `invalid_index` if there are fewer than k points in range
+			size_type index;
+			value_type distance_2;
+		};
+
+	private:
+		struct node_type
+		{
+			// [begin, end) in x_/y_/index_
+			size_type begin;
+			size_type end;
+
+			// children, `invalid_index` for leaves
+			size_type left;
+			size_type right;
+
+			value_type split;
+			// 0 => x, 1 => y
+			std::uint32_t axis;
+		};
+
+		std::vector<value_type> x_;
+		std::vector<value_type> y_;
+		std::vector<size_type> index_;
+
+		std::vector<node_type> nodes_;
+
+		[[nodiscard]] auto build(size_type begin, size_type end) -> size_type;
+
+		// keeps `out` sorted by distance, `count` is the number of valid entries
+		auto search(size_type node, value_type x, value_type y, std::span<neighbor_type> out, std::size_t& count, value_type& worst_2) const noexcept -> void;
+
+	public:
+		KDTree() noexcept = default;
+
+		explicit KDTree(std::span<const Position> points);
+
+		// rebuild the tree over `points`, reuses the storage
+		auto rebuild(std::span<const Position> points) -> void;
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t;
+
+		[[nodiscard]] auto empty() const noexcept -> bool;
+
+		/**
+		 * @brief Find the `out.size()` points closest to `query` within `max_distance_2`, sorted by increasing distance.
+		 * @return the number of neighbors found, the remaining entries of `out` are set to {invalid_index, inf}.
+		 */
+		auto nearest(const Position& query, std::span<neighbor_type> out, value_type max_distance_2 = std::numeric_limits<value_type>::infinity()) const noexcept -> std::size_t;
+
+		// the closest point to `query`, `invalid_index` if the tree is empty
+		[[nodiscard]] auto nearest(const Position& query) const noexcept -> neighbor_type;
+
+		/**
+		 * @brief Batched k-NN for `queries[order[i]]`, the neighbors of query `q` are written to out[q * k, (q + 1) * k).
+		 *
+		 * Queries are processed in the order given by `order` (see `morton_order`), disjoint `order` chunks write disjoint
+		 * parts of `out` and can be processed concurrently on worker threads.
+		 */
+		auto nearest(
+			std::span<const Position> queries,
+			std::span<const size_type> order,
+			std::size_t k,
+			std::span<neighbor_type> out,
+			value_type max_distance_2 = std::numeric_limits<value_type>::infinity()
+		) const noexcept -> void;
+
+		// batched k-NN for all `queries` in Morton order, `out` holds queries.size() * k neighbors
+		auto nearest(
+			std::span<const Position> queries,
+			std::size_t k,
+			std::span<neighbor_type> out,
+			value_type max_distance_2 = std::numeric_limits<value_type>::infinity()
+		) const -> void;
+
+		// indices of `points` sorted by the Morton code of their position (quantized over the bounds of `points`)
+		[[nodiscard]] static auto morton_order(std::span<const Position> points) -> std::vector<size_type>;
+	};
+}
@@ -0,0 +1,126 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include <pb/math/angle.hpp>
+#include <pb/math/angle_batch.hpp>
+
+namespace pb::math
+{
+	/**
+	 * @brief Table of sin/cos for `Resolution` evenly spaced angles of a full turn, linearly interpolated in between.
+	 *
+	 * The table is built at compile time (see `sincos_table`) and only holds `Resolution * 5 / 4 + 1` floats,
+	 * cos reuses the sin entries a quarter turn ahead.
+	 *
+	 * The max interpolation error is about (2 * pi / Resolution)^2 / 8:
+	 * - 256: 7.6e-5 (1.25 KiB)
+	 * - 1024: 4.8e-6 (5 KiB)
+	 * - 4096: 3.0e-7 (20 KiB)
+	 *
+	 * BINARY angles index the table with their top bits, no float conversion at all.
+	 *
+	 * @code
+	 * constexpr auto& table = sincos_table<256>;
+	 * const auto point = angle.rotate_point({1, 0}, table);
+	 * @endcode
+	 */
+	template<std::size_t Resolution>
+		requires(std::has_single_bit(Resolution) and Resolution >= 4 and Resolution <= (std::size_t{1} << 24))
+	class SinCosTable
+	{
+	public:
+		using scalar_type = angle_detail::scalar_type;
+		using size_type = std::size_t;
+
+		constexpr static size_type resolution = Resolution;
+
+	private:
+		constexpr static size_type quarter = Resolution / 4;
+		constexpr static size_type mask = Resolution - 1;
+
+		// [0, 1.25) turn, plus one entry for the interpolation of the last one
+		std::array<scalar_type, Resolution + quarter + 1> sin_;
+
+		[[nodiscard]] constexpr auto lookup(const size_type index, const scalar_type fraction) const noexcept -> std::pair<scalar_type, scalar_type>
+		{
+			const auto s0 = sin_[index];
+			const auto s1 = sin_[index + 1];
+			const auto c0 = sin_[index + quarter];
+			const auto c1 = sin_[index + quarter + 1];
+
+			return {s0 + (s1 - s0) * fraction, c0 + (c1 - c0) * fraction};
+		}
+
+	public:
+		constexpr SinCosTable() noexcept
+			: sin_{}
+		{
+			for (size_type i = 0; i < sin_.size(); ++i)
+			{
+				// exact 0/1 at every quarter turn
+				sin_[i] = angle_batch_detail::sincos(static_cast<scalar_type>(i & mask) * (360.f / static_cast<scalar_type>(Resolution))).first;
+			}
+		}
+
+		// {sin, cos}
+		template<AngleUnit Unit>
+		[[nodiscard]] constexpr auto sincos(const BasicAngle<Unit> angle) const noexcept -> std::pair<scalar_type, scalar_type>
+		{
+			using angle_type = BasicAngle<Unit>;
+
+			if constexpr (Unit == AngleUnit::BINARY)
+			{
+				constexpr auto shift = 32 - std::countr_zero(Resolution);
+
+				const auto value = angle.value();
+				const auto index = static_cast<size_type>(value >> shift);
+				const auto fraction = static_cast<scalar_type>(value & ((std::uint32_t{1} << shift) - 1)) * (1.f / static_cast<scalar_type>(std::uint32_t{1} << shift));
+
+				return lookup(index, fraction);
+			}
+			else
+			{
+				constexpr auto scale = static_cast<scalar_type>(Resolution) / angle_type::traits_type::full_turn;
+
+				const auto position = angle.value() * scale;
+
+				// floor
+				auto integral = static_cast<std::int64_t>(position);
+				if (static_cast<scalar_type>(integral) > position)
+				{
+					integral -= 1;
+				}
+
+				const auto index = static_cast<size_type>(integral) & mask;
+				const auto fraction = position - static_cast<scalar_type>(integral);
+
+				return lookup(index, fraction);
+			}
+		}
+
+		template<AngleUnit Unit>
+		[[nodiscard]] constexpr auto sin(const BasicAngle<Unit> angle) const noexcept -> scalar_type
+		{
+			return sincos(angle).first;
+		}
+
+		template<AngleUnit Unit>
+		[[nodiscard]] constexpr auto cos(const BasicAngle<Unit> angle) const noexcept -> scalar_type
+		{
+			return sincos(angle).second;
+		}
+	};
+
+	template<std::size_t Resolution>
+	constexpr auto sincos_table = SinCosTable<Resolution>{};
+}
@@ -0,0 +1,358 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <pb/macro.hpp>
+#include <pb/math/aabb.hpp>
+#include <pb/math/position.hpp>
+
+#include <glm/vec2.hpp>
+
+// pdep/pext, opt-in: only compiled when the target has BMI2 (`PB_ENABLE_AVX2`, -mbmi2 or /arch:AVX2),
+// a default build uses the magic-bits fallback for every cpu.
+// These functions are constexpr and inlined at every call site, a cpuid dispatch per call would cost more than it saves
+// (and pdep/pext are microcoded and slower than the fallback on AMD cpus before Zen 3).
+// MSVC does not define __BMI2__ but every AVX2 cpu has BMI2
+#if defined(__BMI2__) or (defined(PB_COMPILER_MSVC) and defined(__AVX2__))
+#define PB_MATH_SPACE_FILLING_CURVE_BMI2 1
+#include <immintrin.h>
+#else
+#define PB_MATH_SPACE_FILLING_CURVE_BMI2 0
+#endif
+
+namespace pb::math
+{
+	enum class SpaceFillingCurve : std::uint8_t
+	{
+		// Z-order, bit interleaving, cheapest to compute
+		MORTON,
+		// no jumps between consecutive cells, better locality for a few more cycles per key
+		HILBERT,
+	};
+
+	namespace space_filling_curve_detail
+	{
+		constexpr std::uint64_t even_bits = 0x5555'5555'5555'5555;
+
+		// spread the 32 bits of `value` to the even bits
+		[[nodiscard]] constexpr auto part_1_by_1(const std::uint32_t value) noexcept -> std::uint64_t
+		{
+			auto v = static_cast<std::uint64_t>(value);
+
+			v = (v | (v << 16)) & 0x0000'ffff'0000'ffff;
+			v = (v | (v << 8)) & 0x00ff'00ff'00ff'00ff;
+			v = (v | (v << 4)) & 0x0f0f'0f0f'0f0f'0f0f;
+			v = (v | (v << 2)) & 0x3333'3333'3333'3333;
+			v = (v | (v << 1)) & even_bits;
+
+			return v;
+		}
+
+		// gather the even bits of `value`
+		[[nodiscard]] constexpr auto compact_1_by_1(const std::uint64_t value) noexcept -> std::uint32_t
+		{
+			auto v = value & even_bits;
+
+			v = (v | (v >> 1)) & 0x3333'3333'3333'3333;
+			v = (v | (v >> 2)) & 0x0f0f'0f0f'0f0f'0f0f;
+			v = (v | (v >> 4)) & 0x00ff'00ff'00ff'00ff;
+			v = (v | (v >> 8)) & 0x0000'ffff'0000'ffff;
+			v = (v | (v >> 16)) & 0x0000'0000'ffff'ffff;
+
+			return static_cast<std::uint32_t>(v);
+		}
+
+		// signed grid coordinates keep their order once biased
+		[[nodiscard]] constexpr auto bias(const std::int32_t value) noexcept -> std::uint32_t
+		{
+			return static_cast<std::uint32_t>(value) ^ 0x8000'0000;
+		}
+
+		[[nodiscard]] constexpr auto unbias(const std::uint32_t value) noexcept -> std::int32_t
+		{
+			return static_cast<std::int32_t>(value ^ 0x8000'0000);
+		}
+	}
+
+	// ============================================================
+	// MORTON
+	// ============================================================
+
+	// x in the even bits, y in the odd bits
+	[[nodiscard]] constexpr auto morton_encode(const std::uint32_t x, const std::uint32_t y) noexcept -> std::uint64_t
+	{
+#if PB_MATH_SPACE_FILLING_CURVE_BMI2
+		PB_SEMANTIC_IF_NOT_CONSTANT_EVALUATED
+		{
+			return _pdep_u64(x, space_filling_curve_detail::even_bits) | _pdep_u64(y, space_filling_curve_detail::even_bits << 1);
+		}
+#endif
+
+		return space_filling_curve_detail::part_1_by_1(x) | (space_filling_curve_detail::part_1_by_1(y) << 1);
+	}
+
+	// {x, y}
+	[[nodiscard]] constexpr auto morton_decode(const std::uint64_t code) noexcept -> std::pair<std::uint32_t, std::uint32_t>
+	{
+#if PB_MATH_SPACE_FILLING_CURVE_BMI2
+		PB_SEMANTIC_IF_NOT_CONSTANT_EVALUATED
+		{
+			return {
+					static_cast<std::uint32_t>(_pext_u64(code, space_filling_curve_detail::even_bits)),
+					static_cast<std::uint32_t>(_pext_u64(code, space_filling_curve_detail::even_bits << 1))
+			};
+		}
+#endif
+
+		return {space_filling_curve_detail::compact_1_by_1(code), space_filling_curve_detail::compact_1_by_1(code >> 1)};
+	}
+
+	// signed grid cell (e.g. `SpatialHash` / tilemap coordinates)
+	[[nodiscard]] constexpr auto morton_encode(const glm::ivec2& cell) noexcept -> std::uint64_t
+	{
+		return morton_encode(space_filling_curve_detail::bias(cell.x), space_filling_curve_detail::bias(cell.y));
+	}
+
+	// ============================================================
+	// HILBERT
+	// ============================================================
+
+	// distance of (x, y) along the Hilbert curve filling a 2^Order x 2^Order grid, only the low `Order` bits of x/y are used
+	template<std::size_t Order = 32>
+		requires(Order >= 1 and Order <= 32)
+	[[nodiscard]] constexpr auto hilbert_encode(std::uint32_t x, std::uint32_t y) noexcept -> std::uint64_t
+	{
+		constexpr auto mask = static_cast<std::uint32_t>((std::uint64_t{1} << Order) - 1);
+
+		x &= mask;
+		y &= mask;
+
+		std::uint64_t distance = 0;
+		for (auto s = static_cast<std::uint32_t>(std::uint64_t{1} << (Order - 1)); s > 0; s >>= 1)
+		{
+			const auto rx = (x & s) != 0 ? 1u : 0u;
+			const auto ry = (y & s) != 0 ? 1u : 0u;
+
+			distance += static_cast<std::uint64_t>(s) * s * ((3 * rx) ^ ry);
+
+			// rotate the quadrant
+			if (ry == 0)
+			{
+				if (rx == 1)
+				{
+					x = mask - x;
+					y = mask - y;
+				}
+
+				std::swap(x, y);
+			}
+		}
+
+		return distance;
+	}
+
+	// {x, y}
+	template<std::size_t Order = 32>
+		requires(Order >= 1 and Order <= 32)
+	[[nodiscard]] constexpr auto hilbert_decode(std::uint64_t distance) noexcept -> std::pair<std::uint32_t, std::uint32_t>
+	{
+		std::uint32_t x = 0;
+		std::uint32_t y = 0;
+
+		for (std::uint64_t s = 1; s < (std::uint64_t{1} << Order); s <<= 1)
+		{
+			const auto rx = static_cast<std::uint32_t>(1 & (distance / 2));
+			const auto ry = static_cast<std::uint32_t>(1 & (distance ^ rx));
+
+			// rotate the quadrant
+			if (ry == 0)
+			{
+				if (rx == 1)
+				{
+					x = static_cast<std::uint32_t>(s - 1 - x);
+					y = static_cast<std::uint32_t>(s - 1 - y);
+				}
+
+				std::swap(x, y);
+			}
+
+			x += static_cast<std::uint32_t>(s * rx);
+			y += static_cast<std::uint32_t>(s * ry);
+
+			distance /= 4;
+		}
+
+		return {x, y};
+	}
+
+	// signed grid cell (e.g. `SpatialHash` / tilemap coordinates)
+	[[nodiscard]] constexpr auto hilbert_encode(const glm::ivec2& cell) noexcept -> std::uint64_t
+	{
+		return hilbert_encode(space_filling_curve_detail::bias(cell.x), space_filling_curve_detail::bias(cell.y));
+	}
+
+	// ============================================================
+	// POSITION
+	// ============================================================
+
+	/**
+	 * @brief Maps `Position`s inside `bounds` onto a 2^16 x 2^16 grid, positions outside are clamped to the border.
+	 *
+	 * Keys of positions quantized by the same `SpatialQuantizer` are comparable, keys of different quantizers are not.
+	 */
+	class SpatialQuantizer
+	{
+	public:
+		using value_type = Position::value_type;
+		using key_type = std::uint32_t;
+
+		constexpr static std::uint32_t resolution = 1 << 16;
+
+	private:
+		glm::vec2 min_;
+		value_type scale_;
+
+	public:
+		constexpr explicit SpatialQuantizer(const AABB& bounds) noexcept
+			: min_{bounds.min()},
+			  // square cells, keeps the curve isotropic
+			  scale_{
+					  std::ranges::max(bounds.width(), bounds.height()) > 0
+						  ? static_cast<value_type>(resolution - 1) / std::ranges::max(bounds.width(), bounds.height())
+						  : 0
+			  } {}
+
+		// the bounds of `positions`
+		[[nodiscard]] constexpr static auto from_positions(const std::span<const Position> positions) noexcept -> SpatialQuantizer
+		{
+			if (positions.empty())
+			{
+				return SpatialQuantizer{AABB{}};
+			}
+
+			glm::vec2 min = positions.front();
+			glm::vec2 max = positions.front();
+			for (const auto& position: positions)
+			{
+				min = {std::ranges::min(min.x, position.x()), std::ranges::min(min.y, position.y())};
+				max = {std::ranges::max(max.x, position.x()), std::ranges::max(max.y, position.y())};
+			}
+
+			return SpatialQuantizer{AABB{min, max}};
+		}
+
+		// {x, y} in [0, resolution)
+		[[nodiscard]] constexpr auto quantize(const Position& position) const noexcept -> std::pair<std::uint32_t, std::uint32_t>
+		{
+			constexpr auto max = static_cast<value_type>(resolution - 1);
+
+			const auto x = std::ranges::clamp((position.x() - min_.x) * scale_, value_type{0}, max);
+			const auto y = std::ranges::clamp((position.y() - min_.y) * scale_, value_type{0}, max);
+
+			return {static_cast<std::uint32_t>(x), static_cast<std::uint32_t>(y)};
+		}
+
+		template<SpaceFillingCurve Curve = SpaceFillingCurve::MORTON>
+		[[nodiscard]] constexpr auto key_of(const Position& position) const noexcept -> key_type
+		{
+			const auto [x, y] = quantize(position);
+
+			if constexpr (Curve == SpaceFillingCurve::MORTON)
+			{
+				return static_cast<key_type>(morton_encode(x, y));
+			}
+			else
+			{
+				return static_cast<key_type>(hilbert_encode<16>(x, y));
+			}
+		}
+	};
+
+	/**
+	 * @brief Orders `Position`s along a space filling curve, usable as the comparator of a sort.
+	 *
+	 * @code
+	 * // sort the Position pool, then make the other pools follow it
+	 * const auto quantizer = SpatialQuantizer{world_bounds};
+	 * registry.sort<Position>(SpatialLess{quantizer});
+	 * registry.sort<Velocity, Position>();
+	 * @endcode
+	 */
+	template<SpaceFillingCurve Curve = SpaceFillingCurve::MORTON>
+	class SpatialLess
+	{
+	public:
+		SpatialQuantizer quantizer;
+
+		[[nodiscard]] constexpr auto operator()(const Position& lhs, const Position& rhs) const noexcept -> bool
+		{
+			return quantizer.key_of<Curve>(lhs) < quantizer.key_of<Curve>(rhs);
+		}
+	};
+
+	/**
+	 * @brief Indices of `positions` sorted along `Curve` (quantized over the bounds of `positions`).
+	 *
+	 * Every key is computed once, the (key, index) pairs are packed into 64-bit integers and sorted as such.
+	 */
+	template<SpaceFillingCurve Curve = SpaceFillingCurve::MORTON>
+	[[nodiscard]] auto spatial_order(const std::span<const Position> positions) -> std::vector<std::uint32_t>
+	{
+		const auto quantizer = SpatialQuantizer::from_positions(positions);
+
+		std::vector<std::uint64_t> keys{};
+		keys.reserve(positions.size());
+		for (std::size_t i = 0; i < positions.size(); ++i)
+		{
+			keys.push_back((static_cast<std::uint64_t>(quantizer.key_of<Curve>(positions[i])) << 32) | static_cast<std::uint32_t>(i));
+		}
+
+		std::ranges::sort(keys);
+
+		std::vector<std::uint32_t> order{};
+		order.reserve(keys.size());
+		for (const auto key: keys)
+		{
+			order.push_back(static_cast<std::uint32_t>(key));
+		}
+
+		return order;
+	}
+
+	// values = {values[order[0]], values[order[1]], ...}, use the same `order` for every parallel array
+	template<typename T>
+		requires std::is_move_constructible_v<T>
+	auto reorder(std::vector<T>& values, const std::span<const std::uint32_t> order) -> void
+	{
+		std::vector<T> result{};
+		result.reserve(order.size());
+
+		for (const auto index: order)
+		{
+			result.push_back(std::move(values[index]));
+		}
+
+		values = std::move(result);
+	}
+
+	// sort `positions` along `Curve` in place
+	template<SpaceFillingCurve Curve = SpaceFillingCurve::MORTON>
+	auto spatial_sort(std::vector<Position>& positions) -> void
+	{
+		const auto order = spatial_order<Curve>(positions);
+
+		reorder(positions, order);
+	}
+}
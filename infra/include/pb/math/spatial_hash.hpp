@@ -0,0 +1,541 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <pb/math/position.hpp>
+
+namespace pb::math
+{
+	namespace spatial_hash_detail
+	{
+		using cell_coordinate_type = std::int32_t;
+		using cell_key_type = std::uint64_t;
+
+		[[nodiscard]] constexpr auto make_key(const cell_coordinate_type x, const cell_coordinate_type y) noexcept -> cell_key_type
+		{
+			return (static_cast<cell_key_type>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+		}
+
+		[[nodiscard]] constexpr auto key_x(const cell_key_type key) noexcept -> cell_coordinate_type
+		{
+			return static_cast<cell_coordinate_type>(static_cast<std::uint32_t>(key >> 32));
+		}
+
+		[[nodiscard]] constexpr auto key_y(const cell_key_type key) noexcept -> cell_coordinate_type
+		{
+			return static_cast<cell_coordinate_type>(static_cast<std::uint32_t>(key));
+		}
+	}
+
+	/**
+	 * @brief Uniform grid broad phase, buckets `Handle`s by the cell their `Position` falls into.
+	 *
+	 * Each cell keeps the coordinates of its entities in two contiguous float arrays (SoA),
+	 * a query only tests the cells overlapping its area. The distances over a cell are computed in blocks by a branch-free loop over the coordinates,
+	 * the hits are then compacted and only those look up their handle and invoke the callback.
+	 *
+	 * `move` is O(1): the entity is updated in place if it stays in its cell, otherwise it is swap-removed from the old cell and appended to the new one.
+	 * Empty cells are kept to avoid churn for entities going back and forth, see `shrink`.
+	 *
+	 * Pick a cell size close to the typical query radius, a radius query visits ceil(2 * radius / cell_size + 1)^2 cells.
+	 */
+	template<typename Handle = std::uint32_t>
+	class SpatialHash
+	{
+	public:
+		using handle_type = Handle;
+		using value_type = Position::value_type;
+		using size_type = std::uint32_t;
+
+		using cell_coordinate_type = spatial_hash_detail::cell_coordinate_type;
+		using cell_key_type = spatial_hash_detail::cell_key_type;
+
+	private:
+		struct cell_type
+		{
+			std::vector<value_type> x;
+			std::vector<value_type> y;
+			// index in `entities_`
+			std::vector<size_type> entity;
+		};
+
+		struct entity_type
+		{
+			handle_type handle;
+			cell_key_type cell;
+			// index in `cell_type`
+			size_type slot;
+		};
+
+		value_type cell_size_;
+		value_type inverse_cell_size_;
+
+		std::unordered_map<cell_key_type, cell_type> cells_;
+
+		std::vector<entity_type> entities_;
+		std::unordered_map<handle_type, size_type> handle_to_entity_;
+
+		// infinite or huge values (e.g. a radius meaning "no limit") saturate instead of overflowing the cast
+		[[nodiscard]] constexpr static auto saturate(const value_type cell) noexcept -> cell_coordinate_type
+		{
+			static_assert(std::is_same_v<value_type, float>);
+
+			constexpr auto min = static_cast<value_type>(std::numeric_limits<cell_coordinate_type>::min());
+			// the largest float below 2^31
+			constexpr auto max = 2147483520.f;
+
+			return static_cast<cell_coordinate_type>(std::ranges::clamp(cell, min, max));
+		}
+
+		[[nodiscard]] auto cell_coordinate_of(const value_type value) const noexcept -> cell_coordinate_type
+		{
+			return saturate(std::floor(value * inverse_cell_size_));
+		}
+
+		[[nodiscard]] auto cell_of(const Position& position) const noexcept -> cell_key_type
+		{
+			return spatial_hash_detail::make_key(cell_coordinate_of(position.x()), cell_coordinate_of(position.y()));
+		}
+
+		auto cell_push(const size_type entity, const cell_key_type key, const Position& position) -> void
+		{
+			auto& cell = cells_[key];
+
+			entities_[entity].cell = key;
+			entities_[entity].slot = static_cast<size_type>(cell.entity.size());
+
+			cell.x.push_back(position.x());
+			cell.y.push_back(position.y());
+			cell.entity.push_back(entity);
+		}
+
+		auto cell_erase(const size_type entity) noexcept -> void
+		{
+			const auto slot = entities_[entity].slot;
+			auto& cell = cells_.find(entities_[entity].cell)->second;
+
+			if (const auto last = static_cast<size_type>(cell.entity.size() - 1);
+				slot != last)
+			{
+				cell.x[slot] = cell.x[last];
+				cell.y[slot] = cell.y[last];
+				cell.entity[slot] = cell.entity[last];
+
+				entities_[cell.entity[slot]].slot = slot;
+			}
+
+			cell.x.pop_back();
+			cell.y.pop_back();
+			cell.entity.pop_back();
+		}
+
+		// entities of a cell tested per block by `visit_cell`
+		constexpr static std::size_t visit_block_size = 64;
+
+		// function(handle, position, distance_2)
+		template<typename Function>
+		auto visit_cell(const cell_type& cell, const Position& center, const value_type radius_2, Function& function) const -> void
+		{
+			const auto cx = center.x();
+			const auto cy = center.y();
+
+			std::array<value_type, visit_block_size> distances;
+			std::array<std::uint8_t, visit_block_size> hits;
+
+			const auto size = cell.entity.size();
+			for (std::size_t begin = 0; begin < size; begin += visit_block_size)
+			{
+				const auto count = std::ranges::min(visit_block_size, size - begin);
+				const auto* x = cell.x.data() + begin;
+				const auto* y = cell.y.data() + begin;
+
+				// no branch and no indirection, vectorizable
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					const auto dx = x[i] - cx;
+					const auto dy = y[i] - cy;
+
+					distances[i] = dx * dx + dy * dy;
+				}
+
+				// compact the indices of the hits without branching
+				std::size_t hit_count = 0;
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					hits[hit_count] = static_cast<std::uint8_t>(i);
+					hit_count += distances[i] <= radius_2;
+				}
+
+				for (std::size_t h = 0; h < hit_count; ++h)
+				{
+					const auto i = hits[h];
+					std::invoke(function, entities_[cell.entity[begin + i]].handle, Position{x[i], y[i]}, distances[i]);
+				}
+			}
+		}
+
+		// function(const cell_type&), visits every existing cell in [min, max]
+		template<typename Function>
+		auto visit_cells(
+			const cell_coordinate_type min_x,
+			const cell_coordinate_type min_y,
+			const cell_coordinate_type max_x,
+			const cell_coordinate_type max_y,
+			Function&& function
+		) const -> void
+		{
+			const auto width = static_cast<std::uint64_t>(static_cast<std::int64_t>(max_x) - min_x + 1);
+			const auto height = static_cast<std::uint64_t>(static_cast<std::int64_t>(max_y) - min_y + 1);
+
+			// the area covers more cells than exist, walk the existing ones instead
+			if (width * height > cells_.size())
+			{
+				for (const auto& [key, cell]: cells_)
+				{
+					const auto x = spatial_hash_detail::key_x(key);
+					const auto y = spatial_hash_detail::key_y(key);
+
+					if (x >= min_x and x <= max_x and y >= min_y and y <= max_y)
+					{
+						function(cell);
+					}
+				}
+
+				return;
+			}
+
+			for (auto x = min_x; x <= max_x; ++x)
+			{
+				for (auto y = min_y; y <= max_y; ++y)
+				{
+					if (const auto it = cells_.find(spatial_hash_detail::make_key(x, y));
+						it != cells_.end())
+					{
+						function(it->second);
+					}
+				}
+			}
+		}
+
+	public:
+		explicit SpatialHash(const value_type cell_size) noexcept
+			: cell_size_{cell_size},
+			  inverse_cell_size_{1.f / cell_size} {}
+
+		[[nodiscard]] auto cell_size() const noexcept -> value_type
+		{
+			return cell_size_;
+		}
+
+		[[nodiscard]] auto size() const noexcept -> size_type
+		{
+			return static_cast<size_type>(entities_.size());
+		}
+
+		[[nodiscard]] auto empty() const noexcept -> bool
+		{
+			return entities_.empty();
+		}
+
+		[[nodiscard]] auto contains(const handle_type& handle) const noexcept -> bool
+		{
+			return handle_to_entity_.contains(handle);
+		}
+
+		[[nodiscard]] auto position_of(const handle_type& handle) const noexcept -> std::optional<Position>
+		{
+			const auto it = handle_to_entity_.find(handle);
+			if (it == handle_to_entity_.end())
+			{
+				return std::nullopt;
+			}
+
+			const auto& entity = entities_[it->second];
+			const auto& cell = cells_.find(entity.cell)->second;
+
+			return Position{cell.x[entity.slot], cell.y[entity.slot]};
+		}
+
+		auto reserve(const size_type count) -> void
+		{
+			entities_.reserve(count);
+			handle_to_entity_.reserve(count);
+		}
+
+		auto clear() noexcept -> void
+		{
+			cells_.clear();
+			entities_.clear();
+			handle_to_entity_.clear();
+		}
+
+		// drop the cells that no longer hold any entity
+		auto shrink() -> void
+		{
+			std::erase_if(
+				cells_,
+				[](const auto& pair) noexcept -> bool
+				{
+					return pair.second.entity.empty();
+				}
+			);
+		}
+
+		// false if the handle is already present
+		auto insert(const handle_type& handle, const Position& position) -> bool
+		{
+			const auto entity = static_cast<size_type>(entities_.size());
+
+			if (const auto [it, inserted] = handle_to_entity_.try_emplace(handle, entity);
+				not inserted)
+			{
+				return false;
+			}
+
+			entities_.emplace_back(entity_type{.handle = handle, .cell = 0, .slot = 0});
+			cell_push(entity, cell_of(position), position);
+
+			return true;
+		}
+
+		// false if the handle is not present
+		auto erase(const handle_type& handle) noexcept -> bool
+		{
+			const auto it = handle_to_entity_.find(handle);
+			if (it == handle_to_entity_.end())
+			{
+				return false;
+			}
+
+			const auto entity = it->second;
+			handle_to_entity_.erase(it);
+
+			cell_erase(entity);
+
+			// swap-remove the entity, fix the references to the moved one
+			if (const auto last = static_cast<size_type>(entities_.size() - 1);
+				entity != last)
+			{
+				entities_[entity] = entities_[last];
+
+				const auto& moved = entities_[entity];
+				handle_to_entity_[moved.handle] = entity;
+				cells_.find(moved.cell)->second.entity[moved.slot] = entity;
+			}
+
+			entities_.pop_back();
+			return true;
+		}
+
+		// false if the handle is not present
+		auto move(const handle_type& handle, const Position& position) -> bool
+		{
+			const auto it = handle_to_entity_.find(handle);
+			if (it == handle_to_entity_.end())
+			{
+				return false;
+			}
+
+			const auto entity = it->second;
+			const auto key = cell_of(position);
+
+			if (const auto& e = entities_[entity];
+				e.cell == key)
+			{
+				auto& cell = cells_.find(key)->second;
+				cell.x[e.slot] = position.x();
+				cell.y[e.slot] = position.y();
+
+				return true;
+			}
+
+			cell_erase(entity);
+			cell_push(entity, key, position);
+
+			return true;
+		}
+
+		/**
+		 * @brief Invoke `function(handle, position, distance_2)` for every entity within `radius` of `center`.
+		 * @note The order is unspecified.
+		 */
+		template<typename Function>
+			requires std::is_invocable_v<Function&, const handle_type&, const Position&, value_type>
+		auto query_radius(const Position& center, const value_type radius, Function function) const -> void
+		{
+			const auto radius_2 = radius * radius;
+
+			visit_cells(
+				cell_coordinate_of(center.x() - radius),
+				cell_coordinate_of(center.y() - radius),
+				cell_coordinate_of(center.x() + radius),
+				cell_coordinate_of(center.y() + radius),
+				[&](const cell_type& cell) -> void
+				{
+					visit_cell(cell, center, radius_2, function);
+				}
+			);
+		}
+
+		auto query_radius(const Position& center, const value_type radius, std::vector<handle_type>& out) const -> void
+		{
+			query_radius(
+				center,
+				radius,
+				[&out](const handle_type& handle, const Position&, value_type) -> void
+				{
+					out.push_back(handle);
+				}
+			);
+		}
+
+		/**
+		 * @brief Invoke `function(handle, position)` for every entity inside the box [min, max] (inclusive).
+		 * @note The order is unspecified.
+		 */
+		template<typename Function>
+			requires std::is_invocable_v<Function&, const handle_type&, const Position&>
+		auto query_aabb(const Position& min, const Position& max, Function function) const -> void
+		{
+			const auto min_x = min.x();
+			const auto min_y = min.y();
+			const auto max_x = max.x();
+			const auto max_y = max.y();
+
+			visit_cells(
+				cell_coordinate_of(min_x),
+				cell_coordinate_of(min_y),
+				cell_coordinate_of(max_x),
+				cell_coordinate_of(max_y),
+				[&](const cell_type& cell) -> void
+				{
+					const auto size = cell.entity.size();
+					for (std::size_t i = 0; i < size; ++i)
+					{
+						const auto x = cell.x[i];
+						const auto y = cell.y[i];
+
+						if (x >= min_x and x <= max_x and y >= min_y and y <= max_y)
+						{
+							std::invoke(function, entities_[cell.entity[i]].handle, Position{x, y});
+						}
+					}
+				}
+			);
+		}
+
+		auto query_aabb(const Position& min, const Position& max, std::vector<handle_type>& out) const -> void
+		{
+			query_aabb(
+				min,
+				max,
+				[&out](const handle_type& handle, const Position&) -> void
+				{
+					out.push_back(handle);
+				}
+			);
+		}
+
+		/**
+		 * @brief The closest entity to `center` within `max_radius` for which `filter(handle)` holds.
+		 *
+		 * Cells are visited in rings of growing size around `center`,
+		 * the search stops as soon as no farther ring can hold anything closer than the best candidate.
+		 */
+		template<typename Filter>
+			requires std::is_invocable_r_v<bool, Filter&, const handle_type&>
+		[[nodiscard]] auto nearest(const Position& center, const value_type max_radius, Filter filter) const -> std::optional<handle_type>
+		{
+			std::optional<handle_type> best{};
+			auto best_distance_2 = max_radius * max_radius;
+
+			const auto consider = [&](const handle_type& handle, const Position&, const value_type distance_2) -> void
+			{
+				if (distance_2 <= best_distance_2 and std::invoke(filter, handle))
+				{
+					best = handle;
+					best_distance_2 = distance_2;
+				}
+			};
+
+			const auto center_x = cell_coordinate_of(center.x());
+			const auto center_y = cell_coordinate_of(center.y());
+			// the sparse fallback below is taken long before a saturated `max_ring` could overflow the ring coordinates
+			const auto max_ring = saturate(std::ceil(max_radius * inverse_cell_size_));
+
+			for (cell_coordinate_type ring = 0; ring <= max_ring; ++ring)
+			{
+				// the closest point of ring `ring` is at least (ring - 1) * cell_size away
+				if (const auto ring_distance = static_cast<value_type>(ring - 1) * cell_size_;
+					ring > 1 and ring_distance * ring_distance > best_distance_2)
+				{
+					break;
+				}
+
+				// sparse grid, the remaining rings hold more cells than exist
+				if (const auto side = static_cast<std::uint64_t>(ring) * 2 + 1;
+					side * side > cells_.size())
+				{
+					query_radius(center, std::sqrt(best_distance_2), consider);
+					break;
+				}
+
+				const auto visit = [&](const cell_coordinate_type x, const cell_coordinate_type y) -> void
+				{
+					if (const auto it = cells_.find(spatial_hash_detail::make_key(x, y));
+						it != cells_.end())
+					{
+						visit_cell(it->second, center, best_distance_2, consider);
+					}
+				};
+
+				if (ring == 0)
+				{
+					visit(center_x, center_y);
+					continue;
+				}
+
+				for (auto x = center_x - ring; x <= center_x + ring; ++x)
+				{
+					visit(x, center_y - ring);
+					visit(x, center_y + ring);
+				}
+				for (auto y = center_y - ring + 1; y <= center_y + ring - 1; ++y)
+				{
+					visit(center_x - ring, y);
+					visit(center_x + ring, y);
+				}
+			}
+
+			return best;
+		}
+
+		[[nodiscard]] auto nearest(const Position& center, const value_type max_radius) const -> std::optional<handle_type>
+		{
+			return nearest(
+				center,
+				max_radius,
+				[](const handle_type&) noexcept -> bool
+				{
+					return true;
+				}
+			);
+		}
+	};
+}
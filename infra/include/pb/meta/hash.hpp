@@ -0,0 +1,58 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace pb::infra::meta
+{
+	using hash_type = std::uint64_t;
+
+	namespace hash_detail
+	{
+		constexpr hash_type fnv1a_offset_basis = 0xcbf2'9ce4'8422'2325ull;
+		constexpr hash_type fnv1a_prime = 0x0000'0100'0000'01b3ull;
+	}
+
+	/**
+	 * @brief Feed one code unit into a FNV-1a 64 hash.
+	 * @note Code units wider than one byte are fed byte by byte in little-endian order, the result does not depend on the platform.
+	 */
+	template<typename CharType>
+		requires std::is_integral_v<CharType>
+	[[nodiscard]] constexpr auto fnv1a_append(hash_type hash, const CharType c) noexcept -> hash_type
+	{
+		using unsigned_type = std::make_unsigned_t<CharType>;
+
+		const auto value = static_cast<unsigned_type>(c);
+		for (std::size_t i = 0; i < sizeof(CharType); ++i)
+		{
+			hash ^= static_cast<hash_type>((value >> (i * 8)) & 0xff);
+			hash *= hash_detail::fnv1a_prime;
+		}
+
+		return hash;
+	}
+
+	template<typename CharType>
+	[[nodiscard]] constexpr auto fnv1a(const std::basic_string_view<CharType> string, hash_type seed = hash_detail::fnv1a_offset_basis) noexcept -> hash_type
+	{
+		for (const auto c: string)
+		{
+			seed = meta::fnv1a_append(seed, c);
+		}
+
+		return seed;
+	}
+
+	[[nodiscard]] constexpr auto fnv1a(const std::string_view string, const hash_type seed = hash_detail::fnv1a_offset_basis) noexcept -> hash_type
+	{
+		return meta::fnv1a<char>(string, seed);
+	}
+}
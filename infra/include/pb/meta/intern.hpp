@@ -0,0 +1,154 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <ciso646>
+#include <compare>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <pb/meta/hash.hpp>
+#include <pb/meta/string.hpp>
+
+namespace pb::infra::meta
+{
+	/**
+	 * @brief Small integer handle of an interned string, two handles compare equal iff their strings are equal.
+	 */
+	class InternedString
+	{
+	public:
+		using value_type = std::uint32_t;
+
+		constexpr static auto invalid_value = std::numeric_limits<value_type>::max();
+
+	private:
+		value_type value_;
+
+	public:
+		constexpr explicit InternedString(const value_type value) noexcept
+			: value_{value} {}
+
+		constexpr InternedString() noexcept
+			: InternedString{invalid_value} {}
+
+		[[nodiscard]] constexpr auto value() const noexcept -> value_type
+		{
+			return value_;
+		}
+
+		[[nodiscard]] constexpr auto valid() const noexcept -> bool
+		{
+			return value_ != invalid_value;
+		}
+
+		[[nodiscard]] constexpr auto operator==(const InternedString& other) const noexcept -> bool = default;
+
+		[[nodiscard]] constexpr auto operator<=>(const InternedString& other) const noexcept -> std::strong_ordering = default;
+	};
+
+	/**
+	 * @brief Maps runtime strings to `InternedString` handles.
+	 *
+	 * Strings are hashed with `fnv1a`, the same hash as `basic_fixed_string::hash` / `basic_char_array::hash`,
+	 * so compile time strings can be interned/looked up without hashing at runtime.
+	 * Interned strings are never released, `view` stays valid as long as the interner lives.
+	 *
+	 * Thread-safe, lookups only take a shared lock.
+	 */
+	class StringInterner
+	{
+	public:
+		using handle_type = InternedString;
+		using value_type = handle_type::value_type;
+
+	private:
+		struct entry_type
+		{
+			std::string_view view;
+			hash_type hash;
+			// next entry with the same hash
+			value_type next;
+		};
+
+		mutable std::shared_mutex mutex_;
+
+		// std::deque never moves its elements, `entry_type::view` points into it
+		std::deque<std::string> storage_;
+		std::vector<entry_type> entries_;
+		// hash => first entry with the hash
+		std::unordered_map<hash_type, value_type> buckets_;
+
+		[[nodiscard]] auto do_find(std::string_view string, hash_type hash) const noexcept -> handle_type;
+
+	public:
+		[[nodiscard]] auto intern(std::string_view string, hash_type hash) -> handle_type;
+
+		[[nodiscard]] auto intern(const std::string_view string) -> handle_type
+		{
+			return intern(string, meta::fnv1a(string));
+		}
+
+		template<typename String>
+			requires(string_detail::is_meta_string_base_v<String> and std::is_same_v<typename String::value_type, char>)
+		[[nodiscard]] auto intern(const String& string) -> handle_type
+		{
+			return intern(string.template as<std::string_view>(), string.hash());
+		}
+
+		// invalid handle if not interned
+		[[nodiscard]] auto find(std::string_view string, hash_type hash) const noexcept -> handle_type;
+
+		// invalid handle if not interned
+		[[nodiscard]] auto find(const std::string_view string) const noexcept -> handle_type
+		{
+			return find(string, meta::fnv1a(string));
+		}
+
+		// invalid handle if not interned
+		template<typename String>
+			requires(string_detail::is_meta_string_base_v<String> and std::is_same_v<typename String::value_type, char>)
+		[[nodiscard]] auto find(const String& string) const noexcept -> handle_type
+		{
+			return find(string.template as<std::string_view>(), string.hash());
+		}
+
+		// empty string if the handle is invalid
+		[[nodiscard]] auto view(handle_type handle) const noexcept -> std::string_view;
+
+		[[nodiscard]] auto hash(handle_type handle) const noexcept -> hash_type;
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t;
+	};
+
+	// the process-wide interner
+	[[nodiscard]] auto string_interner() noexcept -> StringInterner&;
+
+	[[nodiscard]] inline auto intern(const std::string_view string) -> InternedString
+	{
+		return string_interner().intern(string);
+	}
+}
+
+namespace std
+{
+	template<>
+	struct hash<pb::infra::meta::InternedString> // NOLINT(cert-dcl58-cpp)
+	{
+		[[nodiscard]] auto operator()(const pb::infra::meta::InternedString& string) const noexcept -> std::size_t
+		{
+			return string.value();
+		}
+	};
+}
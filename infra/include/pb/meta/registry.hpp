@@ -0,0 +1,282 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <ciso646>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <pb/macro.hpp>
+
+#include <pb/meta/hash.hpp>
+#include <pb/meta/name.hpp>
+#include <pb/meta/type_id.hpp>
+#include <pb/meta/member.hpp>
+#include <pb/meta/enumeration.hpp>
+
+namespace pb::infra::meta
+{
+	using type_id_type = std::uint32_t;
+
+	constexpr auto type_id_unknown = std::numeric_limits<type_id_type>::max();
+	constexpr auto member_offset_unknown = std::numeric_limits<std::size_t>::max();
+
+	enum class TypeCategory : std::uint8_t
+	{
+		// bool/char/int/float...
+		FUNDAMENTAL,
+		// enum/enum class
+		ENUMERATION,
+		// aggregate type, members are reflected
+		AGGREGATE,
+		// any other type, only name/size/alignment are recorded
+		OPAQUE,
+	};
+
+	struct MemberDescriptor
+	{
+		std::string_view name;
+		// offsetof(owner, member), or `member_offset_unknown` if the member is not addressable
+		std::size_t offset;
+		type_id_type type;
+	};
+
+	struct EnumeratorDescriptor
+	{
+		// the underlying value, sign-extended for signed enumerations
+		std::uint64_t value;
+		std::string_view name;
+	};
+
+	struct TypeDescriptor
+	{
+		type_id_type id;
+		TypeCategory category;
+
+		// type_hash<T>(), stable across compilers/processes, use it for serialization instead of `id`
+		hash_type hash;
+
+		std::string_view name;
+		std::size_t size;
+		std::size_t alignment;
+
+		// [member_offset, member_offset + member_count) in `TypeRegistry::members()`
+		std::uint32_t member_offset;
+		std::uint32_t member_count;
+
+		// [enumerator_offset, enumerator_offset + enumerator_count) in `TypeRegistry::enumerators()`
+		std::uint32_t enumerator_offset;
+		std::uint32_t enumerator_count;
+	};
+
+	namespace registry_detail
+	{
+		template<typename T>
+		constexpr auto is_reflectable_aggregate_v =
+				std::is_class_v<T> and
+				std::is_aggregate_v<T> and
+				std::is_default_constructible_v<T> and
+				not member_detail::is_tuple_structured_binding_v<T> and
+				member_detail::is_known_member_size_v<T>;
+
+		[[nodiscard]] constexpr auto is_valid_enumerator_name(const std::string_view full_name) noexcept -> bool
+		{
+			// see `enumeration_detail::is_valid_enum`
+			if (full_name.starts_with("(anonymous namespace)::"))
+			{
+				return not full_name.starts_with("(anonymous namespace)::(");
+			}
+			return not full_name.starts_with('(');
+		}
+	}
+
+	/**
+	 * @brief Runtime table of type descriptors generated from compile time reflection.
+	 *
+	 * All descriptors, members and enumerators are stored in three contiguous arrays,
+	 * a type only refers to a sub-range of the latter two. Registering a type also registers
+	 * the types of its members, so `MemberDescriptor::type` can always be resolved through `type_of`.
+	 *
+	 * Registration is expected to happen at startup (see `PB_META_REGISTER_TYPE`), lookups are read-only.
+	 */
+	class TypeRegistry
+	{
+	public:
+		using types_type = std::vector<TypeDescriptor>;
+		using members_type = std::vector<MemberDescriptor>;
+		using enumerators_type = std::vector<EnumeratorDescriptor>;
+
+	private:
+		types_type types_;
+		members_type members_;
+		enumerators_type enumerators_;
+
+		std::unordered_map<hash_type, type_id_type> hash_to_id_;
+
+		[[nodiscard]] auto reserve(hash_type hash, std::string_view name) -> std::pair<type_id_type, bool>;
+
+		template<typename T, std::size_t... Index>
+		auto add_members(const type_id_type id, std::index_sequence<Index...>) -> void
+		{
+			// register all member types first, their own members must not be interleaved with ours
+			const type_id_type member_types[]{add<member_type_of_index<Index, const T&>>()...};
+
+			const auto offset_of = []<std::size_t I>() noexcept -> std::size_t
+			{
+				const auto& object = member_detail::extern_any<T>;
+
+				if constexpr (std::is_lvalue_reference_v<decltype(meta::member_of_index<I>(object))>)
+				{
+					const auto* base = reinterpret_cast<const std::byte*>(std::addressof(object));
+					const auto* member = reinterpret_cast<const std::byte*>(std::addressof(meta::member_of_index<I>(object)));
+					return static_cast<std::size_t>(member - base);
+				}
+				else
+				{
+					return member_offset_unknown;
+				}
+			};
+
+			auto& descriptor = types_[id];
+			descriptor.member_offset = static_cast<std::uint32_t>(members_.size());
+			descriptor.member_count = static_cast<std::uint32_t>(sizeof...(Index));
+
+			(members_.emplace_back(
+				 MemberDescriptor{
+						 .name = meta::name_of_member<Index, T>(),
+						 .offset = offset_of.template operator()<Index>(),
+						 .type = member_types[Index]
+				 }
+			 ),
+			 ...);
+		}
+
+		template<typename T>
+		auto add_enumerators(const type_id_type id) -> void
+		{
+			constexpr auto full_names = meta::names_of<T, EnumNamePolicy::FULL>();
+			constexpr auto names = meta::names_of<T>();
+			static_assert(full_names.size() == names.size());
+
+			auto& descriptor = types_[id];
+			descriptor.enumerator_offset = static_cast<std::uint32_t>(enumerators_.size());
+
+			for (std::size_t i = 0; i < names.size(); ++i)
+			{
+				if (not registry_detail::is_valid_enumerator_name(full_names[i].second))
+				{
+					continue;
+				}
+
+				enumerators_.emplace_back(
+					EnumeratorDescriptor{
+							.value = static_cast<std::uint64_t>(std::to_underlying(names[i].first)),
+							.name = names[i].second
+					}
+				);
+			}
+
+			descriptor.enumerator_count = static_cast<std::uint32_t>(enumerators_.size() - descriptor.enumerator_offset);
+		}
+
+	public:
+		/**
+		 * @brief Register `T` (and recursively the types of its members), returns the id of `T`.
+		 * @note Registering the same type more than once is allowed and returns the same id.
+		 */
+		template<typename T>
+		auto add() -> type_id_type
+		{
+			using type = std::remove_cvref_t<T>;
+
+			const auto type_id = meta::type_id<type>();
+			const auto [id, inserted] = reserve(type_id.value(), type_id.name());
+			if (not inserted)
+			{
+				return id;
+			}
+
+			auto& descriptor = types_[id];
+			descriptor.size = sizeof(type);
+			descriptor.alignment = alignof(type);
+
+			if constexpr (std::is_enum_v<type>)
+			{
+				descriptor.category = TypeCategory::ENUMERATION;
+				add_enumerators<type>(id);
+			}
+			else if constexpr (std::is_fundamental_v<type>)
+			{
+				descriptor.category = TypeCategory::FUNDAMENTAL;
+			}
+			else if constexpr (registry_detail::is_reflectable_aggregate_v<type>)
+			{
+				descriptor.category = TypeCategory::AGGREGATE;
+				if constexpr (meta::member_size<type>() != 0)
+				{
+					add_members<type>(id, std::make_index_sequence<meta::member_size<type>()>{});
+				}
+			}
+			else
+			{
+				descriptor.category = TypeCategory::OPAQUE;
+			}
+
+			return id;
+		}
+
+		[[nodiscard]] auto types() const noexcept -> std::span<const TypeDescriptor>;
+
+		[[nodiscard]] auto members() const noexcept -> std::span<const MemberDescriptor>;
+
+		[[nodiscard]] auto enumerators() const noexcept -> std::span<const EnumeratorDescriptor>;
+
+		[[nodiscard]] auto members_of(const TypeDescriptor& descriptor) const noexcept -> std::span<const MemberDescriptor>;
+
+		[[nodiscard]] auto enumerators_of(const TypeDescriptor& descriptor) const noexcept -> std::span<const EnumeratorDescriptor>;
+
+		// nullptr if not registered
+		[[nodiscard]] auto type_of(type_id_type id) const noexcept -> const TypeDescriptor*;
+
+		// nullptr if not registered
+		[[nodiscard]] auto find(hash_type hash) const noexcept -> const TypeDescriptor*;
+
+		// nullptr if not registered
+		[[nodiscard]] auto find(std::string_view name) const noexcept -> const TypeDescriptor*;
+
+		// nullptr if not registered
+		template<typename T>
+		[[nodiscard]] auto find() const noexcept -> const TypeDescriptor*
+		{
+			return find(meta::type_hash<std::remove_cvref_t<T>>());
+		}
+	};
+
+	// the process-wide registry used by `PB_META_REGISTER_TYPE`
+	[[nodiscard]] auto type_registry() noexcept -> TypeRegistry&;
+
+	template<typename T>
+	struct type_registrar
+	{
+		type_registrar()
+		{
+			std::ignore = type_registry().add<T>();
+		}
+	};
+}
+
+// PB_META_REGISTER_TYPE(my_namespace::MyStruct);
+// PB_META_REGISTER_TYPE(my_namespace::MyEnum);
+#define PB_META_REGISTER_TYPE(type) \
+	[[maybe_unused]] static const ::pb::infra::meta::type_registrar<type> PB_UTILITY_STRING_CAT(pb_meta_type_registrar_, __LINE__){}
@@ -15,6 +15,8 @@
 
 #include <pb/macro.hpp>
 
+#include <pb/meta/hash.hpp>
+
 namespace pb::infra::meta
 {
 	/**
@@ -94,7 +96,7 @@ namespace pb::infra::meta
 		template<typename Container, typename ValueType = typename Container::value_type>
 		struct default_comparator
 		{
-			using const_reference = std::add_const_t<std::add_lvalue_reference_t<std::remove_cvref_t<ValueType>>>;
+			using const_reference = std::add_lvalue_reference_t<std::add_const_t<std::remove_cvref_t<ValueType>>>;
 
 			[[nodiscard]] constexpr auto operator()(const_reference left, const_reference right) const noexcept(noexcept(left == right))
 			{
@@ -308,6 +310,15 @@ namespace pb::infra::meta
 			template<typename StringType>
 			constexpr static auto is_constructible_from_view_v = std::is_constructible_v<StringType, basic_string_view<value_type>>;
 
+			// contiguous storage of `value_type` + default_getter + default_comparator => char_traits::compare (memcmp)
+			template<typename Container, typename Getter, typename Comparator>
+			constexpr static auto is_trivially_matchable_v =
+					std::ranges::contiguous_range<const Container> and
+					std::ranges::sized_range<const Container> and
+					std::is_same_v<std::ranges::range_value_t<const Container>, value_type> and
+					std::is_same_v<Getter, default_getter<Container, size_type>> and
+					std::is_same_v<Comparator, default_comparator<Container, value_type>>;
+
 		public:
 			// =================================================
 
@@ -345,6 +356,23 @@ namespace pb::infra::meta
 
 			// =================================================
 
+			// same as `fnv1a(basic_string_view<value_type>{...})`, a runtime string with the same content has the same hash
+			[[nodiscard]] constexpr auto hash() const noexcept -> hash_type //
+				requires(not lazy_is_static<derived_type>())
+			{
+				return meta::fnv1a(this->template as<basic_string_view<value_type>>());
+			}
+
+			// same as `fnv1a(basic_string_view<value_type>{...})`, a runtime string with the same content has the same hash
+			[[nodiscard]] constexpr static auto hash() noexcept -> hash_type //
+				requires(lazy_is_static<derived_type>())
+			{
+				constexpr auto value = meta::fnv1a(basic_string_view<value_type>{meta_string_base::rep_value(), meta_string_base::rep_size()});
+				return value;
+			}
+
+			// =================================================
+
 			template<typename Pointer>
 			[[nodiscard]] friend constexpr auto operator==(const derived_type& lhs, Pointer string) noexcept -> bool //
 				requires(lazy_is_pointer<derived_type, Pointer>()) //
@@ -400,7 +428,7 @@ namespace pb::infra::meta
 				requires(not lazy_is_static<derived_type>())
 			{
 				//
-				return *this == rhs;
+				return this->template as<basic_string_view<value_type>>() == basic_string_view<value_type>{rhs};
 			}
 
 			template<typename String>
@@ -423,22 +451,25 @@ namespace pb::infra::meta
 			) const noexcept(noexcept(comparator(getter(container, 0), rep_value()[0]))) -> bool //
 				requires(not lazy_is_static<derived_type>())
 			{
-				if (std::ranges::equal(std::ranges::size(container), rep_size()))
+				if (std::ranges::size(container) != rep_size())
 				{
 					return false;
 				}
 
-				return std::ranges::all_of(
-					std::views::iota(static_cast<size_type>(0), rep_size()),
-					[comparator](const auto& pair) noexcept(noexcept(comparator(pair.first, pair.second)))
-					{
-						return comparator(pair.first, pair.second);
-					},
-					[this, &container, getter](const auto index) noexcept(noexcept(getter(container, index)))
-					{
-						return std::make_pair(std::cref(getter(container, index)), std::cref(rep_value()[index]));
-					}
-				);
+				if constexpr (is_trivially_matchable_v<Container, Getter, Comparator>)
+				{
+					return std::char_traits<value_type>::compare(std::ranges::data(container), rep_value(), rep_size()) == 0;
+				}
+				else
+				{
+					return std::ranges::all_of(
+						std::views::iota(static_cast<size_type>(0), rep_size()),
+						[this, &container, getter, comparator](const auto index) noexcept(noexcept(comparator(getter(container, index), rep_value()[index]))) -> bool
+						{
+							return comparator(getter(container, index), rep_value()[index]);
+						}
+					);
+				}
 			}
 
 			// container + getter + comparator
@@ -452,22 +483,25 @@ namespace pb::infra::meta
 			) noexcept(noexcept(comparator(getter(container, 0), rep_value()[0]))) -> bool //
 				requires(lazy_is_static<derived_type>())
 			{
-				if (std::ranges::equal(std::ranges::size(container), rep_size()))
+				if (std::ranges::size(container) != rep_size())
 				{
 					return false;
 				}
 
-				return std::ranges::all_of(
-					std::views::iota(static_cast<size_type>(0), rep_size()),
-					[comparator](const auto& pair) noexcept(noexcept(comparator(pair.first, pair.second)))
-					{
-						return comparator(pair.first, pair.second);
-					},
-					[&container, getter](const auto index) noexcept(noexcept(getter(container, index)))
-					{
-						return std::make_pair(std::cref(getter(container, index)), std::cref(rep_value()[index]));
-					}
-				);
+				if constexpr (is_trivially_matchable_v<Container, Getter, Comparator>)
+				{
+					return std::char_traits<value_type>::compare(std::ranges::data(container), rep_value(), rep_size()) == 0;
+				}
+				else
+				{
+					return std::ranges::all_of(
+						std::views::iota(static_cast<size_type>(0), rep_size()),
+						[&container, getter, comparator](const auto index) noexcept(noexcept(comparator(getter(container, index), rep_value()[index]))) -> bool
+						{
+							return comparator(getter(container, index), rep_value()[index]);
+						}
+					);
+				}
 			}
 
 			// container + default_getter + comparator
@@ -527,8 +561,8 @@ namespace pb::infra::meta
 			}
 
 			// container + default_getter + default_comparator
-			template<typename Container, typename Getter>
-				requires getter_t<Container, Getter, size_type>
+			template<typename Container>
+				requires(getter_t<Container, default_getter<Container, size_type>, size_type> and not std::is_constructible_v<basic_string_view<value_type>, Container>)
 			[[nodiscard]] constexpr auto match(
 				const Container& container //
 			) const noexcept(noexcept(default_comparator<Container, value_type>{
@@ -537,7 +571,7 @@ namespace pb::infra::meta
 				requires(not lazy_is_static<derived_type>())
 			{
 				//
-				return this->template match<Container, Getter, default_comparator<Container, value_type>>(
+				return this->template match<Container, default_getter<Container, size_type>, default_comparator<Container, value_type>>(
 					container,
 					default_getter<Container, size_type>{},
 					default_comparator<Container, value_type>{}
@@ -545,8 +579,8 @@ namespace pb::infra::meta
 			}
 
 			// container + default_getter + default_comparator
-			template<typename Container, typename Getter>
-				requires getter_t<Container, Getter, size_type>
+			template<typename Container>
+				requires(getter_t<Container, default_getter<Container, size_type>, size_type> and not std::is_constructible_v<basic_string_view<value_type>, Container>)
 			[[nodiscard]] constexpr static auto match(
 				const Container& container //
 			) noexcept(noexcept(default_comparator<Container, value_type>{
@@ -555,7 +589,7 @@ namespace pb::infra::meta
 				requires(lazy_is_static<derived_type>())
 			{
 				//
-				return meta_string_base::match<Container, Getter, default_comparator<Container, value_type>>(
+				return meta_string_base::match<Container, default_getter<Container, size_type>, default_comparator<Container, value_type>>(
 					container,
 					default_getter<Container, size_type>{},
 					default_comparator<Container, value_type>{}
@@ -798,6 +832,24 @@ namespace pb::infra::meta
 
 namespace std
 {
+	template<pb::infra::meta::basic_char_array_t CharArray>
+	struct hash<CharArray> // NOLINT(cert-dcl58-cpp)
+	{
+		[[nodiscard]] constexpr auto operator()(const CharArray& char_array) const noexcept -> std::size_t
+		{
+			return static_cast<std::size_t>(char_array.hash());
+		}
+	};
+
+	template<pb::infra::meta::basic_fixed_string_t FixedString>
+	struct hash<FixedString> // NOLINT(cert-dcl58-cpp)
+	{
+		[[nodiscard]] constexpr auto operator()(const FixedString& fixed_string) const noexcept -> std::size_t
+		{
+			return static_cast<std::size_t>(fixed_string.hash());
+		}
+	};
+
 	// for `std::totally_ordered_with`
 	template<pb::infra::meta::basic_char_array_t FixedString, typename String, template<typename> typename Q1, template<typename> typename Q2>
 		requires std::is_constructible_v<pb::infra::meta::basic_string_view<typename FixedString::value_type>, String>
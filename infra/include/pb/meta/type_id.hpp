@@ -0,0 +1,182 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <algorithm>
+#include <ciso646>
+#include <compare>
+#include <functional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include <pb/macro.hpp>
+
+#include <pb/meta/hash.hpp>
+#include <pb/meta/name.hpp>
+
+namespace pb::infra::meta
+{
+	namespace type_id_detail
+	{
+		[[nodiscard]] constexpr auto is_identifier(const char c) noexcept -> bool
+		{
+			return (c >= 'a' and c <= 'z') or (c >= 'A' and c <= 'Z') or (c >= '0' and c <= '9') or c == '_';
+		}
+
+		/**
+		 * MSVC
+		 * struct std::pair<int,class std::basic_string_view<char,struct std::char_traits<char> > >
+		 * CLANG
+		 * std::pair<int, std::basic_string_view<char, std::char_traits<char>>>
+		 * GCC
+		 * std::pair<int, std::basic_string_view<char> >
+		 *
+		 * The elaborated type specifiers (`struct `/`class `/`enum `/`union `) are dropped and whitespace is only kept between two identifiers (`unsigned int`),
+		 * so `struct my_namespace::MyStruct<int,float>` and `my_namespace::MyStruct<int, float>` hash the same.
+		 * Default template arguments (see `basic_string_view` above) and spellings such as `__int64` are NOT unified,
+		 * only types whose printed names agree after normalization have a stable hash across compilers.
+		 */
+		[[nodiscard]] constexpr auto normalized_hash(const std::string_view name) noexcept -> hash_type
+		{
+			constexpr std::string_view keywords[]{"struct ", "class ", "enum ", "union "};
+
+			auto hash = hash_detail::fnv1a_offset_basis;
+			// the last character fed into the hash
+			char last = '\0';
+
+			for (std::string_view::size_type i = 0; i < name.size();)
+			{
+				const auto c = name[i];
+
+				if (not is_identifier(last))
+				{
+					const auto rest = name.substr(i);
+
+					if (const auto it = std::ranges::find_if(
+							keywords,
+							[rest](const std::string_view keyword) noexcept -> bool
+							{
+								return rest.starts_with(keyword);
+							}
+						);
+						it != std::ranges::end(keywords))
+					{
+						i += it->size();
+						continue;
+					}
+				}
+
+				if (c == ' ')
+				{
+					if (const auto next = i + 1 < name.size() ? name[i + 1] : '\0';
+						not is_identifier(last) or not is_identifier(next))
+					{
+						i += 1;
+						continue;
+					}
+				}
+
+				hash = meta::fnv1a_append(hash, c);
+				last = c;
+				i += 1;
+			}
+
+			return hash;
+		}
+	}
+
+	/**
+	 * @brief Hash of a (possibly compiler specific) type name, same as `type_hash<T>()` if `name == name_of<T>()`.
+	 */
+	[[nodiscard]] constexpr auto type_hash(const std::string_view name) noexcept -> hash_type
+	{
+		return type_id_detail::normalized_hash(name);
+	}
+
+	template<typename T>
+	[[nodiscard]] constexpr auto type_hash() noexcept -> hash_type
+	{
+		constexpr auto hash = meta::type_hash(meta::name_of<T>());
+		return hash;
+	}
+
+	class TypeId
+	{
+	public:
+		using value_type = hash_type;
+
+	private:
+		value_type value_;
+		std::string_view name_;
+
+	public:
+		constexpr TypeId(const value_type value, const std::string_view name) noexcept
+			: value_{value},
+			  name_{name} {}
+
+		[[nodiscard]] constexpr auto value() const noexcept -> value_type
+		{
+			return value_;
+		}
+
+		// for debugging only, the name is compiler specific
+		[[nodiscard]] constexpr auto name() const noexcept -> std::string_view
+		{
+			return name_;
+		}
+
+		[[nodiscard]] constexpr auto operator==(const TypeId& other) const noexcept -> bool
+		{
+			return value_ == other.value_;
+		}
+
+		[[nodiscard]] constexpr auto operator<=>(const TypeId& other) const noexcept -> std::strong_ordering
+		{
+			return value_ <=> other.value_;
+		}
+	};
+
+#if PB_COMPILER_DEBUG
+	namespace type_id_detail
+	{
+		// panic if another type with a different name has already been checked with the same hash
+		auto check_collision(hash_type hash, std::string_view name) noexcept -> bool;
+
+		// every type that goes through `type_id<T>()` is checked once during static initialization
+		template<typename T>
+		inline const bool collision_checked = type_id_detail::check_collision(meta::type_hash<T>(), meta::name_of<T>());
+	}
+#endif
+
+	// `T` is decayed (like `name_of`), `type_id<const T&>() == type_id<T>()`
+	template<typename T>
+	[[nodiscard]] constexpr auto type_id() noexcept -> TypeId
+	{
+		using type = std::decay_t<T>;
+
+#if PB_COMPILER_DEBUG
+		PB_SEMANTIC_IF_NOT_CONSTANT_EVALUATED
+		{
+			std::ignore = type_id_detail::collision_checked<type>;
+		}
+#endif
+
+		return {meta::type_hash<type>(), meta::name_of<type>()};
+	}
+}
+
+namespace std
+{
+	template<>
+	struct hash<pb::infra::meta::TypeId> // NOLINT(cert-dcl58-cpp)
+	{
+		[[nodiscard]] auto operator()(const pb::infra::meta::TypeId& type_id) const noexcept -> std::size_t
+		{
+			return static_cast<std::size_t>(type_id.value());
+		}
+	};
+}
@@ -0,0 +1,85 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace pb::infra::platform
+{
+	/**
+	 * @brief Reports files that were written since the last `poll`, without blocking.
+	 *
+	 * Linux watches the parent directories with inotify (editors usually save by writing a temporary file and renaming it over the original),
+	 * other platforms compare the last write time of every watched file at most every `scan_interval`.
+	 *
+	 * @code
+	 * FileWatcher watcher;
+	 * watcher.watch("assets/player.png");
+	 *
+	 * // once per frame
+	 * changed.clear();
+	 * watcher.poll(changed);
+	 * for (const auto& path: changed) { reload(path); }
+	 * @endcode
+	 */
+	class FileWatcher
+	{
+	public:
+		constexpr static std::chrono::milliseconds scan_interval{250};
+
+	private:
+		struct file_type
+		{
+			// as given to `watch`
+			std::filesystem::path path;
+			std::filesystem::file_time_type time;
+		};
+
+		struct directory_type
+		{
+			// inotify watch descriptor
+			int watch;
+			// file name => file
+			std::unordered_map<std::string, file_type> files;
+		};
+
+		// inotify instance, -1 if not used
+		int descriptor_;
+
+		// absolute directory => watched files in it
+		std::unordered_map<std::string, directory_type> directories_;
+		// inotify watch descriptor => absolute directory
+		std::unordered_map<int, std::string> watches_;
+
+		std::chrono::steady_clock::time_point last_scan_;
+
+	public:
+		// @throw OsError if the notification facility cannot be created.
+		FileWatcher();
+
+		FileWatcher(const FileWatcher&) = delete;
+		FileWatcher(FileWatcher&&) = delete;
+		auto operator=(const FileWatcher&) -> FileWatcher& = delete;
+		auto operator=(FileWatcher&&) -> FileWatcher& = delete;
+
+		~FileWatcher() noexcept;
+
+		/**
+		 * @brief Report writes to `path` (a file, it does not have to exist yet).
+		 * @return false if the parent directory cannot be watched.
+		 */
+		auto watch(const std::filesystem::path& path) -> bool;
+
+		auto unwatch(const std::filesystem::path& path) -> void;
+
+		// append every watched file written since the last call to `changed` (once per file, as given to `watch`)
+		auto poll(std::vector<std::filesystem::path>& changed) -> void;
+	};
+}
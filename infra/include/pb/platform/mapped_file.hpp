@@ -0,0 +1,52 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace pb::infra::platform
+{
+	/**
+	 * @brief Read-only memory mapping of a whole file (mmap / MapViewOfFile).
+	 *
+	 * The mapped bytes stay valid (and at the same address) until the mapping is destroyed, moving the object does not remap.
+	 */
+	class MappedFile
+	{
+	public:
+		using size_type = std::size_t;
+
+	private:
+		const std::byte* data_;
+		size_type size_;
+
+		auto unmap() noexcept -> void;
+
+	public:
+		MappedFile() noexcept;
+
+		// @throw OsError if the file cannot be opened or mapped.
+		explicit MappedFile(const std::filesystem::path& path);
+
+		MappedFile(const MappedFile&) = delete;
+		auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+		MappedFile(MappedFile&& other) noexcept;
+		auto operator=(MappedFile&& other) noexcept -> MappedFile&;
+
+		~MappedFile() noexcept;
+
+		[[nodiscard]] auto empty() const noexcept -> bool;
+
+		[[nodiscard]] auto size() const noexcept -> size_type;
+
+		[[nodiscard]] auto data() const noexcept -> const std::byte*;
+
+		[[nodiscard]] auto bytes() const noexcept -> std::span<const std::byte>;
+	};
+}
@@ -0,0 +1,183 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <pb/meta/hash.hpp>
+#include <pb/platform/exception.hpp>
+#include <pb/platform/mapped_file.hpp>
+
+namespace pb::infra::utility
+{
+	class PackError final : public platform::Exception<void>
+	{
+	public:
+		using Exception::Exception;
+
+		[[noreturn]] static auto panic(
+			std::string message,
+			const std::source_location& location = std::source_location::current(),
+			std::stacktrace stacktrace = std::stacktrace::current()
+		) noexcept(false) -> void //
+		{
+			platform::panic<PackError>(std::move(message), location, std::move(stacktrace));
+		}
+	};
+
+	enum class PackCompression : std::uint8_t
+	{
+		// the entry is stored as is and can be read in place
+		NONE,
+		// reserved, no codec is linked yet, `PackWriter` never produces it
+		LZ4,
+		// reserved, no codec is linked yet, `PackWriter` never produces it
+		ZSTD,
+	};
+
+	namespace pack_detail
+	{
+		// all fields are little endian
+
+		constexpr std::array<char, 4> magic{'P', 'B', 'P', 'K'};
+		constexpr std::uint32_t version = 1;
+
+		constexpr std::uint32_t empty_bucket = 0xffff'ffff;
+
+		struct header_type
+		{
+			std::array<char, 4> magic;
+			std::uint32_t version;
+			std::uint32_t entry_count;
+			// power of two, at least twice `entry_count`
+			std::uint32_t bucket_count;
+			// of the entry data
+			std::uint32_t alignment;
+			std::uint32_t reserved;
+			std::uint64_t entry_offset;
+			std::uint64_t bucket_offset;
+			std::uint64_t string_offset;
+		};
+
+		struct entry_type
+		{
+			meta::hash_type hash;
+			std::uint64_t offset;
+			// stored bytes
+			std::uint64_t size;
+			// bytes after decompression
+			std::uint64_t original_size;
+			// in the string table, not null terminated
+			std::uint32_t path_offset;
+			std::uint32_t path_size;
+			PackCompression compression;
+			std::array<std::uint8_t, 7> reserved;
+		};
+
+		static_assert(sizeof(header_type) == 48);
+		static_assert(sizeof(entry_type) == 48);
+	}
+
+	struct PackEntry
+	{
+		std::string_view path;
+		// the stored bytes, in the mapping
+		std::span<const std::byte> data;
+		PackCompression compression;
+		std::uint64_t original_size;
+	};
+
+	/**
+	 * @brief Read-only asset archive, the whole file is mapped once and entries are read in place.
+	 *
+	 * Layout: header | entries | hash buckets (open addressing, linear probing) | path strings | aligned entry data.
+	 * `find` hashes the path once and usually touches a single bucket and entry, independent of the entry count.
+	 */
+	class Pack
+	{
+	public:
+		using size_type = std::uint32_t;
+
+	private:
+		platform::MappedFile file_;
+
+		const pack_detail::header_type* header_;
+		std::span<const pack_detail::entry_type> entries_;
+		std::span<const std::uint32_t> buckets_;
+		std::string_view strings_;
+
+		[[nodiscard]] auto make_entry(const pack_detail::entry_type& entry) const noexcept -> PackEntry;
+
+	public:
+		// the key of an entry: the lexically normal generic form of its path
+		[[nodiscard]] static auto normalize(const std::filesystem::path& path) -> std::string;
+
+		[[nodiscard]] static auto hash_of(std::string_view normalized_path) noexcept -> meta::hash_type;
+
+		Pack() noexcept;
+
+		// @throw PackError if the file cannot be mapped or is not a valid pack.
+		explicit Pack(const std::filesystem::path& path);
+
+		[[nodiscard]] auto size() const noexcept -> size_type;
+
+		[[nodiscard]] auto entry(size_type index) const noexcept -> PackEntry;
+
+		// `path` must be normalized (see `normalize`)
+		[[nodiscard]] auto find(std::string_view path) const noexcept -> std::optional<PackEntry>;
+
+		[[nodiscard]] auto find(const std::filesystem::path& path) const -> std::optional<PackEntry>;
+	};
+
+	/**
+	 * @brief Builds a `Pack` file.
+	 */
+	class PackWriter
+	{
+	public:
+		using size_type = std::uint32_t;
+
+		constexpr static size_type default_alignment = 16;
+
+	private:
+		struct file_type
+		{
+			std::string path;
+			// read when the pack is written
+			std::filesystem::path source;
+			// used if `source` is empty
+			std::vector<std::byte> data;
+		};
+
+		std::vector<file_type> files_;
+
+	public:
+		// store the content of `source` as `path` (normalized)
+		auto add(const std::filesystem::path& path, std::filesystem::path source) -> void;
+
+		// store `data` as `path` (normalized)
+		auto add(const std::filesystem::path& path, std::vector<std::byte> data) -> void;
+
+		[[nodiscard]] auto size() const noexcept -> size_type;
+
+		/**
+		 * @brief Write all added files to `destination`, every entry starts at a multiple of `alignment` (a power of two).
+		 * The pack is written to `destination` + ".tmp" (removed on failure) then renamed over `destination`.
+		 * @note On Windows, `destination` cannot be replaced while it is mapped (by a `Pack`, e.g. in a running game), `write` throws.
+		 * @throw PackError if two files have the same path or a file cannot be read / written.
+		 */
+		auto write(const std::filesystem::path& destination, size_type alignment = default_alignment) const -> void;
+	};
+}
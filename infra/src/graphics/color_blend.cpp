@@ -0,0 +1,594 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <pb/graphics/color_blend.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <exception>
+
+#include <pb/macro.hpp>
+#include <pb/platform/os.hpp>
+
+#if defined(__SSE2__) or defined(_M_X64) or (defined(_M_IX86_FP) and _M_IX86_FP >= 2)
+#define PB_GRAPHICS_COLOR_BLEND_SSE2 1
+#include <emmintrin.h>
+#else
+#define PB_GRAPHICS_COLOR_BLEND_SSE2 0
+#endif
+
+namespace
+{
+	using namespace pb::infra::graphics;
+
+	using value_type = Color::value_type;
+
+	static_assert(sizeof(Color) == 4 and std::is_standard_layout_v<Color>);
+	static_assert(sizeof(PremultipliedColor) == 4 and std::is_standard_layout_v<PremultipliedColor>);
+
+	[[nodiscard]] auto srgb_to_linear_exact(const float value) noexcept -> float
+	{
+		return value <= .04045f ? value / 12.92f : std::pow((value + .055f) / 1.055f, 2.4f);
+	}
+
+	[[nodiscard]] auto linear_to_srgb_exact(const float value) noexcept -> float
+	{
+		return value <= .0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.f / 2.4f) - .055f;
+	}
+
+	// [0, 1] => [0, max], rounded
+	[[nodiscard]] auto quantize(const float value, const float max) noexcept -> std::int32_t
+	{
+		return static_cast<std::int32_t>(std::ranges::clamp(value, 0.f, 1.f) * max + .5f);
+	}
+
+	// ============================================================
+	// SCALAR
+	// ============================================================
+
+	// r, g, b, a
+	using channels_type = std::array<float, 4>;
+
+	[[nodiscard]] auto decode(const Color& color, const BlendSpace space) noexcept -> channels_type
+	{
+		constexpr auto scale = 1.f / 255.f;
+
+		if (space == BlendSpace::LINEAR)
+		{
+			const auto& table = srgb_to_linear_table();
+			return {table[color.red], table[color.green], table[color.blue], static_cast<float>(color.alpha) * scale};
+		}
+
+		return {
+				static_cast<float>(color.red) * scale,
+				static_cast<float>(color.green) * scale,
+				static_cast<float>(color.blue) * scale,
+				static_cast<float>(color.alpha) * scale
+		};
+	}
+
+	[[nodiscard]] auto encode(const channels_type& channels, const BlendSpace space) noexcept -> Color
+	{
+		const auto alpha = static_cast<value_type>(quantize(channels[3], 255.f));
+
+		if (space == BlendSpace::LINEAR)
+		{
+			const auto& table = linear_to_srgb_table();
+			constexpr auto max = static_cast<float>(linear_to_srgb_table_size - 1);
+
+			return {.red = table[quantize(channels[0], max)], .green = table[quantize(channels[1], max)], .blue = table[quantize(channels[2], max)], .alpha = alpha};
+		}
+
+		return {
+				.red = static_cast<value_type>(quantize(channels[0], 255.f)),
+				.green = static_cast<value_type>(quantize(channels[1], 255.f)),
+				.blue = static_cast<value_type>(quantize(channels[2], 255.f)),
+				.alpha = alpha
+		};
+	}
+
+	// premultiply, lerp, unpremultiply
+	[[nodiscard]] auto blend(const channels_type& from, const channels_type& to, const float t) noexcept -> channels_type
+	{
+		channels_type result;
+
+		for (std::size_t i = 0; i < 3; ++i)
+		{
+			const auto f = from[i] * from[3];
+			const auto s = to[i] * to[3];
+			result[i] = f + (s - f) * t;
+		}
+		result[3] = from[3] + (to[3] - from[3]) * t;
+
+		for (std::size_t i = 0; i < 3; ++i)
+		{
+			result[i] = result[3] == 0 ? 0 : result[i] / result[3];
+		}
+
+		return result;
+	}
+
+#if PB_GRAPHICS_COLOR_BLEND_SSE2
+	// ============================================================
+	// SSE2
+	// ============================================================
+
+	[[nodiscard]] auto to_bytes(const Color& color) noexcept -> std::int32_t
+	{
+		return std::bit_cast<std::int32_t>(color);
+	}
+
+	// one 16-bit lane per channel: r, g, b, a (x4 pixels in 2 registers)
+	[[nodiscard]] auto broadcast_alpha_epi16(const __m128i pixels) noexcept -> __m128i
+	{
+		return _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+	}
+
+	// see `color_blend_detail::mul_div_255`
+	[[nodiscard]] auto mul_div_255_epi16(const __m128i a, const __m128i b) noexcept -> __m128i
+	{
+		const auto v = _mm_add_epi16(_mm_mullo_epi16(a, b), _mm_set1_epi16(128));
+		return _mm_srli_epi16(_mm_add_epi16(v, _mm_srli_epi16(v, 8)), 8);
+	}
+
+	// 4 pixels
+	[[nodiscard]] auto premultiply_epi8(const __m128i pixels) noexcept -> __m128i
+	{
+		const auto zero = _mm_setzero_si128();
+		// the alpha lane is multiplied by 255
+		const auto rgb_mask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+		const auto alpha_255 = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+
+		const auto multiply = [&](const __m128i p) noexcept -> __m128i
+		{
+			const auto factor = _mm_or_si128(_mm_and_si128(broadcast_alpha_epi16(p), rgb_mask), alpha_255);
+			return mul_div_255_epi16(p, factor);
+		};
+
+		const auto low = multiply(_mm_unpacklo_epi8(pixels, zero));
+		const auto high = multiply(_mm_unpackhi_epi8(pixels, zero));
+
+		return _mm_packus_epi16(low, high);
+	}
+
+	// 4 pixels
+	[[nodiscard]] auto over_epi8(const __m128i source, const __m128i destination) noexcept -> __m128i
+	{
+		const auto zero = _mm_setzero_si128();
+		const auto v255 = _mm_set1_epi16(255);
+
+		const auto compose = [&](const __m128i s, const __m128i d) noexcept -> __m128i
+		{
+			const auto inverse_alpha = _mm_sub_epi16(v255, broadcast_alpha_epi16(s));
+			return _mm_add_epi16(s, mul_div_255_epi16(d, inverse_alpha));
+		};
+
+		const auto low = compose(_mm_unpacklo_epi8(source, zero), _mm_unpacklo_epi8(destination, zero));
+		const auto high = compose(_mm_unpackhi_epi8(source, zero), _mm_unpackhi_epi8(destination, zero));
+
+		return _mm_packus_epi16(low, high);
+	}
+
+	// 4 pixels, one register per channel
+	struct planes_type
+	{
+		__m128 red;
+		__m128 green;
+		__m128 blue;
+		__m128 alpha;
+	};
+
+	// the channel at bit `Shift` of 4 pixels, one 32-bit lane per pixel
+	template<int Shift>
+	[[nodiscard]] auto channel_epi32(const __m128i pixels) noexcept -> __m128i
+	{
+		return _mm_and_si128(_mm_srli_epi32(pixels, Shift), _mm_set1_epi32(0xff));
+	}
+
+	// channels in [0, 255] => 4 pixels
+	[[nodiscard]] auto interleave_epi32(const __m128i red, const __m128i green, const __m128i blue, const __m128i alpha) noexcept -> __m128i
+	{
+		return _mm_or_si128(
+			_mm_or_si128(red, _mm_slli_epi32(green, 8)),
+			_mm_or_si128(_mm_slli_epi32(blue, 16), _mm_slli_epi32(alpha, 24))
+		);
+	}
+
+	// see `PremultipliedColor::to_color`, 4 pixels
+	[[nodiscard]] auto unpremultiply_epi8(const __m128i pixels) noexcept -> __m128i
+	{
+		const auto alpha = channel_epi32<24>(pixels);
+		const auto alpha_ps = _mm_cvtepi32_ps(alpha);
+		const auto half_alpha = _mm_srli_epi32(alpha, 1);
+		const auto zero_mask = _mm_cmpeq_epi32(alpha, _mm_setzero_si128());
+		const auto max = _mm_set1_ps(255.f);
+
+		// (value * 255 + alpha / 2) / alpha, exact in float (no quotient is within 2^-24 of an integer)
+		// 0 / 0 => 0, invalid colors (channel > alpha) saturate to 255
+		const auto divide = [&](const __m128i value) noexcept -> __m128i
+		{
+			const auto numerator = _mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(value, 8), value), half_alpha);
+			const auto quotient = _mm_cvttps_epi32(_mm_min_ps(_mm_div_ps(_mm_cvtepi32_ps(numerator), alpha_ps), max));
+			return _mm_andnot_si128(zero_mask, quotient);
+		};
+
+		return interleave_epi32(
+			divide(channel_epi32<0>(pixels)),
+			divide(channel_epi32<8>(pixels)),
+			divide(channel_epi32<16>(pixels)),
+			alpha
+		);
+	}
+
+	// 4 pixels, r, g, b, a in [0, 1]
+	[[nodiscard]] auto decode_ps(const Color* colors, const BlendSpace space, const std::array<float, srgb_to_linear_table_size>& table) noexcept -> planes_type
+	{
+		const auto pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(colors));
+		const auto scale = _mm_set1_ps(1.f / 255.f);
+
+		const auto unit = [&](const __m128i channel) noexcept -> __m128
+		{
+			return _mm_mul_ps(_mm_cvtepi32_ps(channel), scale);
+		};
+
+		if (space == BlendSpace::LINEAR)
+		{
+			// no gather in SSE2
+			return {
+					.red = _mm_set_ps(table[colors[3].red], table[colors[2].red], table[colors[1].red], table[colors[0].red]),
+					.green = _mm_set_ps(table[colors[3].green], table[colors[2].green], table[colors[1].green], table[colors[0].green]),
+					.blue = _mm_set_ps(table[colors[3].blue], table[colors[2].blue], table[colors[1].blue], table[colors[0].blue]),
+					.alpha = unit(channel_epi32<24>(pixels))
+			};
+		}
+
+		return {
+				.red = unit(channel_epi32<0>(pixels)),
+				.green = unit(channel_epi32<8>(pixels)),
+				.blue = unit(channel_epi32<16>(pixels)),
+				.alpha = unit(channel_epi32<24>(pixels))
+		};
+	}
+
+	// see `quantize`
+	[[nodiscard]] auto quantize_epi32(const __m128 value, const float max) noexcept -> __m128i
+	{
+		const auto clamped = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.f));
+		return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, _mm_set1_ps(max)), _mm_set1_ps(.5f)));
+	}
+
+	// 4 pixels
+	[[nodiscard]] auto encode_epi8(const planes_type& planes, const BlendSpace space, const std::array<value_type, linear_to_srgb_table_size>& table) noexcept -> __m128i
+	{
+		const auto alpha = quantize_epi32(planes.alpha, 255.f);
+
+		if (space == BlendSpace::LINEAR)
+		{
+			constexpr auto max = static_cast<float>(linear_to_srgb_table_size - 1);
+
+			alignas(16) std::array<std::int32_t, 4> red;
+			alignas(16) std::array<std::int32_t, 4> green;
+			alignas(16) std::array<std::int32_t, 4> blue;
+			_mm_store_si128(reinterpret_cast<__m128i*>(red.data()), quantize_epi32(planes.red, max));
+			_mm_store_si128(reinterpret_cast<__m128i*>(green.data()), quantize_epi32(planes.green, max));
+			_mm_store_si128(reinterpret_cast<__m128i*>(blue.data()), quantize_epi32(planes.blue, max));
+
+			alignas(16) std::array<std::int32_t, 4> rgb;
+			for (std::size_t i = 0; i < rgb.size(); ++i)
+			{
+				rgb[i] = table[red[i]] | table[green[i]] << 8 | table[blue[i]] << 16;
+			}
+
+			return _mm_or_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(rgb.data())), _mm_slli_epi32(alpha, 24));
+		}
+
+		return interleave_epi32(quantize_epi32(planes.red, 255.f), quantize_epi32(planes.green, 255.f), quantize_epi32(planes.blue, 255.f), alpha);
+	}
+
+	// see `blend`, 4 pixels
+	[[nodiscard]] auto blend_ps(const planes_type& from, const planes_type& to, const __m128 t) noexcept -> planes_type
+	{
+		const auto lerp = [t](const __m128 a, const __m128 b) noexcept -> __m128
+		{
+			return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t));
+		};
+
+		const auto alpha = lerp(from.alpha, to.alpha);
+		const auto zero_mask = _mm_cmpeq_ps(alpha, _mm_setzero_ps());
+
+		// premultiply, lerp, unpremultiply
+		const auto mix = [&](const __m128 f, const __m128 s) noexcept -> __m128
+		{
+			const auto mixed = lerp(_mm_mul_ps(f, from.alpha), _mm_mul_ps(s, to.alpha));
+			return _mm_andnot_ps(zero_mask, _mm_div_ps(mixed, alpha));
+		};
+
+		return {
+				.red = mix(from.red, to.red),
+				.green = mix(from.green, to.green),
+				.blue = mix(from.blue, to.blue),
+				.alpha = alpha
+		};
+	}
+
+	// see `Color::blend_u8`, 4 pixels
+	[[nodiscard]] auto blend_u8_epi8(const __m128i from, const __m128i to, const __m128i weight, const __m128i inverse_weight) noexcept -> __m128i
+	{
+		const auto zero = _mm_setzero_si128();
+		const auto half = _mm_set1_epi16(128);
+
+		// at most 255 * 256 + 128, fits in an unsigned 16-bit lane
+		const auto lerp = [&](const __m128i a, const __m128i b) noexcept -> __m128i
+		{
+			const auto sum = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(a, inverse_weight), _mm_mullo_epi16(b, weight)), half);
+			return _mm_srli_epi16(sum, 8);
+		};
+
+		const auto low = lerp(_mm_unpacklo_epi8(from, zero), _mm_unpacklo_epi8(to, zero));
+		const auto high = lerp(_mm_unpackhi_epi8(from, zero), _mm_unpackhi_epi8(to, zero));
+
+		return _mm_packus_epi16(low, high);
+	}
+
+	// see `Color::luminance_u8`, 4 pixels => 4 bytes
+	[[nodiscard]] auto luminance_u8_epi8(const __m128i pixels) noexcept -> std::int32_t
+	{
+		const auto zero = _mm_setzero_si128();
+		const auto weights = _mm_set_epi16(0, 29, 150, 77, 0, 29, 150, 77);
+
+		// {r * 77 + g * 150, b * 29} per pixel
+		const auto low = _mm_madd_epi16(_mm_unpacklo_epi8(pixels, zero), weights);
+		const auto high = _mm_madd_epi16(_mm_unpackhi_epi8(pixels, zero), weights);
+
+		const auto even = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(low), _mm_castsi128_ps(high), _MM_SHUFFLE(2, 0, 2, 0)));
+		const auto odd = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(low), _mm_castsi128_ps(high), _MM_SHUFFLE(3, 1, 3, 1)));
+
+		const auto luminance = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(even, odd), _mm_set1_epi32(128)), 8);
+
+		const auto packed = _mm_packs_epi32(luminance, luminance);
+		return _mm_cvtsi128_si32(_mm_packus_epi16(packed, packed));
+	}
+#endif
+}
+
+namespace pb::infra::graphics
+{
+	auto srgb_to_linear_table() noexcept -> const std::array<float, srgb_to_linear_table_size>&
+	{
+		static const auto table = []() noexcept -> std::array<float, srgb_to_linear_table_size>
+		{
+			std::array<float, srgb_to_linear_table_size> result;
+			for (std::size_t i = 0; i < result.size(); ++i)
+			{
+				result[i] = srgb_to_linear_exact(static_cast<float>(i) / 255.f);
+			}
+
+			return result;
+		}();
+
+		return table;
+	}
+
+	auto linear_to_srgb_table() noexcept -> const std::array<Color::value_type, linear_to_srgb_table_size>&
+	{
+		static const auto table = []() noexcept -> std::array<Color::value_type, linear_to_srgb_table_size>
+		{
+			std::array<Color::value_type, linear_to_srgb_table_size> result;
+			for (std::size_t i = 0; i < result.size(); ++i)
+			{
+				const auto linear = static_cast<float>(i) / static_cast<float>(linear_to_srgb_table_size - 1);
+				result[i] = static_cast<Color::value_type>(quantize(linear_to_srgb_exact(linear), 255.f));
+			}
+
+			return result;
+		}();
+
+		return table;
+	}
+
+	auto srgb_to_linear(const Color::value_type value) noexcept -> float
+	{
+		return srgb_to_linear_table()[value];
+	}
+
+	auto linear_to_srgb(const float value) noexcept -> Color::value_type
+	{
+		return linear_to_srgb_table()[quantize(value, static_cast<float>(linear_to_srgb_table_size - 1))];
+	}
+
+	auto LinearColor::from(const Color& color) noexcept -> LinearColor
+	{
+		const auto alpha = static_cast<value_type>(color.alpha) / 255.f;
+
+		return {
+				.red = srgb_to_linear(color.red) * alpha,
+				.green = srgb_to_linear(color.green) * alpha,
+				.blue = srgb_to_linear(color.blue) * alpha,
+				.alpha = alpha
+		};
+	}
+
+	auto LinearColor::to_color() const noexcept -> Color
+	{
+		if (alpha <= 0)
+		{
+			return {.red = 0, .green = 0, .blue = 0, .alpha = 0};
+		}
+
+		return {
+				.red = linear_to_srgb(red / alpha),
+				.green = linear_to_srgb(green / alpha),
+				.blue = linear_to_srgb(blue / alpha),
+				.alpha = static_cast<Color::value_type>(quantize(alpha, 255.f))
+		};
+	}
+
+	auto premultiply(const std::span<const Color> source, const std::span<PremultipliedColor> destination) noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(destination.size() >= source.size());
+
+		std::size_t i = 0;
+
+#if PB_GRAPHICS_COLOR_BLEND_SSE2
+		for (; i + 4 <= source.size(); i += 4)
+		{
+			const auto pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source.data() + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination.data() + i), premultiply_epi8(pixels));
+		}
+#endif
+
+		for (; i < source.size(); ++i)
+		{
+			destination[i] = PremultipliedColor::from(source[i]);
+		}
+	}
+
+	auto unpremultiply(const std::span<const PremultipliedColor> source, const std::span<Color> destination) noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(destination.size() >= source.size());
+
+		std::size_t i = 0;
+
+#if PB_GRAPHICS_COLOR_BLEND_SSE2
+		for (; i + 4 <= source.size(); i += 4)
+		{
+			const auto pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source.data() + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination.data() + i), unpremultiply_epi8(pixels));
+		}
+#endif
+
+		for (; i < source.size(); ++i)
+		{
+			destination[i] = source[i].to_color();
+		}
+	}
+
+	auto over(const std::span<const PremultipliedColor> source, const std::span<PremultipliedColor> destination) noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(destination.size() >= source.size());
+
+		std::size_t i = 0;
+
+#if PB_GRAPHICS_COLOR_BLEND_SSE2
+		for (; i + 4 <= source.size(); i += 4)
+		{
+			const auto s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source.data() + i));
+			const auto d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination.data() + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination.data() + i), over_epi8(s, d));
+		}
+#endif
+
+		for (; i < source.size(); ++i)
+		{
+			destination[i] = source[i].over(destination[i]);
+		}
+	}
+
+	auto blend_span(
+		const std::span<const Color> from,
+		const std::span<const Color> to,
+		const float t,
+		const std::span<Color> out,
+		const BlendSpace space
+	) noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(to.size() >= from.size());
+		PB_ERROR_DEBUG_ASSUME(out.size() >= from.size());
+
+		std::size_t i = 0;
+
+#if PB_GRAPHICS_COLOR_BLEND_SSE2
+		const auto& decode_table = srgb_to_linear_table();
+		const auto& encode_table = linear_to_srgb_table();
+		const auto vt = _mm_set1_ps(t);
+
+		for (; i + 4 <= from.size(); i += 4)
+		{
+			const auto blended = blend_ps(decode_ps(from.data() + i, space, decode_table), decode_ps(to.data() + i, space, decode_table), vt);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out.data() + i), encode_epi8(blended, space, encode_table));
+		}
+#endif
+
+		for (; i < from.size(); ++i)
+		{
+			out[i] = encode(blend(decode(from[i], space), decode(to[i], space), t), space);
+		}
+	}
+
+	auto blend_u8(const std::span<const Color> from, const std::span<const Color> to, const Color::value_type t, const std::span<Color> out) noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(to.size() >= from.size());
+		PB_ERROR_DEBUG_ASSUME(out.size() >= from.size());
+
+		std::size_t i = 0;
+
+#if PB_GRAPHICS_COLOR_BLEND_SSE2
+		const auto weight = static_cast<std::int16_t>(t + (t >> 7));
+		const auto vw = _mm_set1_epi16(weight);
+		const auto viw = _mm_set1_epi16(static_cast<std::int16_t>(256 - weight));
+
+		for (; i + 4 <= from.size(); i += 4)
+		{
+			const auto f = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from.data() + i));
+			const auto s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(to.data() + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out.data() + i), blend_u8_epi8(f, s, vw, viw));
+		}
+#endif
+
+		for (; i < from.size(); ++i)
+		{
+			out[i] = from[i].blend_u8(to[i], t);
+		}
+	}
+
+	auto blend_u8(const std::span<const Color> from, const Color& to, const Color::value_type t, const std::span<Color> out) noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(out.size() >= from.size());
+
+		std::size_t i = 0;
+
+#if PB_GRAPHICS_COLOR_BLEND_SSE2
+		const auto weight = static_cast<std::int16_t>(t + (t >> 7));
+		const auto vw = _mm_set1_epi16(weight);
+		const auto viw = _mm_set1_epi16(static_cast<std::int16_t>(256 - weight));
+		const auto s = _mm_set1_epi32(to_bytes(to));
+
+		for (; i + 4 <= from.size(); i += 4)
+		{
+			const auto f = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from.data() + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out.data() + i), blend_u8_epi8(f, s, vw, viw));
+		}
+#endif
+
+		for (; i < from.size(); ++i)
+		{
+			out[i] = from[i].blend_u8(to, t);
+		}
+	}
+
+	auto luminance_u8(const std::span<const Color> colors, const std::span<Color::value_type> out) noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(out.size() >= colors.size());
+
+		std::size_t i = 0;
+
+#if PB_GRAPHICS_COLOR_BLEND_SSE2
+		for (; i + 4 <= colors.size(); i += 4)
+		{
+			const auto pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(colors.data() + i));
+			const auto luminance = luminance_u8_epi8(pixels);
+			std::memcpy(out.data() + i, &luminance, sizeof(luminance));
+		}
+#endif
+
+		for (; i < colors.size(); ++i)
+		{
+			out[i] = colors[i].luminance_u8();
+		}
+	}
+}
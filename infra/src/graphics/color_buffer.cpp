@@ -0,0 +1,423 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <pb/graphics/color_buffer.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+
+#include <pb/macro.hpp>
+#include <pb/platform/os.hpp>
+
+// the SSSE3/AVX2 kernels are compiled for their own target and picked at runtime from the cpuid,
+// a default build (without -mssse3/-mavx2 or /arch:AVX2) still uses them on CPUs that support them
+#if defined(__x86_64__) or defined(__i386__) or defined(_M_X64) or (defined(_M_IX86) and not defined(_M_ARM64EC))
+#define PB_GRAPHICS_COLOR_BUFFER_X86 1
+#include <immintrin.h>
+#if defined(PB_COMPILER_MSVC) or defined(PB_COMPILER_CLANG_CL)
+#include <intrin.h>
+#endif
+#else
+#define PB_GRAPHICS_COLOR_BUFFER_X86 0
+#endif
+
+// MSVC emits any intrinsic regardless of /arch, GCC/Clang need the target of the function
+#if PB_GRAPHICS_COLOR_BUFFER_X86 and (defined(__GNUC__) or defined(__clang__))
+#define PB_GRAPHICS_COLOR_BUFFER_TARGET(isa) __attribute__((target(isa)))
+#else
+#define PB_GRAPHICS_COLOR_BUFFER_TARGET(isa)
+#endif
+
+namespace
+{
+	using namespace pb::infra::graphics;
+
+	using pixel_type = universal_32_bit_color_type;
+
+	// the byte is zero
+	constexpr std::uint8_t no_channel = 0x80;
+
+	// byte index (little endian) of every channel in a 32-bit value
+	struct layout_type
+	{
+		std::uint8_t red;
+		std::uint8_t green;
+		std::uint8_t blue;
+		// `no_channel` if the format has no alpha (opaque)
+		std::uint8_t alpha;
+	};
+
+	[[nodiscard]] constexpr auto layout_of(const ColorFormat format) noexcept -> layout_type
+	{
+		// see `Color::from` / `Color::to`
+		switch (format)
+		{
+			case ColorFormat::R_G_B:
+			{
+				return {.red = 2, .green = 1, .blue = 0, .alpha = no_channel};
+			}
+			case ColorFormat::R_G_B_A:
+			{
+				return {.red = 3, .green = 2, .blue = 1, .alpha = 0};
+			}
+			case ColorFormat::A_R_G_B:
+			{
+				return {.red = 2, .green = 1, .blue = 0, .alpha = 3};
+			}
+			case ColorFormat::B_G_R:
+			{
+				return {.red = 0, .green = 1, .blue = 2, .alpha = no_channel};
+			}
+			case ColorFormat::B_G_R_A:
+			{
+				return {.red = 1, .green = 2, .blue = 3, .alpha = 0};
+			}
+			case ColorFormat::A_B_G_R:
+			{
+				return {.red = 0, .green = 1, .blue = 2, .alpha = 3};
+			}
+		}
+
+		PB_COMPILER_UNREACHABLE();
+	}
+
+	// destination byte `i` = source byte `index[i]` (or 0), then `| fill`
+	struct shuffle_type
+	{
+		std::array<std::uint8_t, 4> index;
+		pixel_type fill;
+
+		[[nodiscard]] constexpr auto identity() const noexcept -> bool
+		{
+			return index == std::array<std::uint8_t, 4>{0, 1, 2, 3} and fill == 0;
+		}
+	};
+
+	[[nodiscard]] constexpr auto make_shuffle(const ColorFormat from, const ColorFormat to) noexcept -> shuffle_type
+	{
+		const auto source = layout_of(from);
+		const auto destination = layout_of(to);
+
+		shuffle_type shuffle{.index = {no_channel, no_channel, no_channel, no_channel}, .fill = 0};
+
+		shuffle.index[destination.red] = source.red;
+		shuffle.index[destination.green] = source.green;
+		shuffle.index[destination.blue] = source.blue;
+
+		if (destination.alpha != no_channel)
+		{
+			if (source.alpha != no_channel)
+			{
+				shuffle.index[destination.alpha] = source.alpha;
+			}
+			else
+			{
+				// `Color::from` makes formats without alpha opaque
+				shuffle.fill = pixel_type{0xff} << (8 * destination.alpha);
+			}
+		}
+
+		return shuffle;
+	}
+
+	static_assert(make_shuffle(ColorFormat::R_G_B_A, ColorFormat::R_G_B_A).identity());
+	static_assert(make_shuffle(ColorFormat::A_R_G_B, ColorFormat::A_R_G_B).identity());
+	// the unused byte is cleared
+	static_assert(not make_shuffle(ColorFormat::R_G_B, ColorFormat::R_G_B).identity());
+
+	auto convert_scalar(const pixel_type* source, pixel_type* destination, const std::size_t count, const shuffle_type& shuffle) noexcept -> void
+	{
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const auto pixel = source[i];
+
+			auto result = shuffle.fill;
+			for (std::size_t byte = 0; byte < 4; ++byte)
+			{
+				if (const auto index = shuffle.index[byte];
+					index != no_channel)
+				{
+					result |= ((pixel >> (8 * index)) & 0xff) << (8 * byte);
+				}
+			}
+
+			destination[i] = result;
+		}
+	}
+
+	using kernel_type = auto (*)(const pixel_type* source, pixel_type* destination, std::size_t count, const shuffle_type& shuffle) noexcept -> void;
+
+#if PB_GRAPHICS_COLOR_BUFFER_X86
+	// the pshufb mask of 4 consecutive pixels
+	[[nodiscard]] constexpr auto make_mask(const shuffle_type& shuffle) noexcept -> std::array<std::uint8_t, 16>
+	{
+		std::array<std::uint8_t, 16> mask{};
+		for (std::size_t pixel = 0; pixel < 4; ++pixel)
+		{
+			for (std::size_t byte = 0; byte < 4; ++byte)
+			{
+				const auto index = shuffle.index[byte];
+
+				mask[pixel * 4 + byte] = index == no_channel ? no_channel : static_cast<std::uint8_t>(pixel * 4 + index);
+			}
+		}
+
+		return mask;
+	}
+
+	PB_GRAPHICS_COLOR_BUFFER_TARGET("ssse3")
+	auto convert_ssse3(const pixel_type* source, pixel_type* destination, std::size_t count, const shuffle_type& shuffle) noexcept -> void
+	{
+		const auto mask_bytes = make_mask(shuffle);
+		const auto mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask_bytes.data()));
+		const auto fill = _mm_set1_epi32(static_cast<int>(shuffle.fill));
+
+		for (; count >= 4; count -= 4, source += 4, destination += 4)
+		{
+			const auto pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+			const auto result = _mm_or_si128(_mm_shuffle_epi8(pixels, mask), fill);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination), result);
+		}
+
+		convert_scalar(source, destination, count, shuffle);
+	}
+
+	PB_GRAPHICS_COLOR_BUFFER_TARGET("avx2")
+	auto convert_avx2(const pixel_type* source, pixel_type* destination, std::size_t count, const shuffle_type& shuffle) noexcept -> void
+	{
+		const auto mask_bytes = make_mask(shuffle);
+		const auto mask = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(mask_bytes.data())));
+		const auto fill = _mm256_set1_epi32(static_cast<int>(shuffle.fill));
+
+		// pshufb shuffles within each 128-bit lane, the mask of 4 pixels is the same for both lanes
+		for (; count >= 8; count -= 8, source += 8, destination += 8)
+		{
+			const auto pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source));
+			const auto result = _mm256_or_si256(_mm256_shuffle_epi8(pixels, mask), fill);
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination), result);
+		}
+
+		convert_ssse3(source, destination, count, shuffle);
+	}
+
+	struct cpu_features_type
+	{
+		bool ssse3;
+		bool avx2;
+	};
+
+	[[nodiscard]] auto cpu_features() noexcept -> cpu_features_type
+	{
+#if defined(PB_COMPILER_MSVC) or defined(PB_COMPILER_CLANG_CL)
+		std::array<int, 4> info{};
+
+		__cpuid(info.data(), 0);
+		const auto max_leaf = info[0];
+
+		__cpuid(info.data(), 1);
+		const auto ssse3 = (info[2] & (1 << 9)) != 0;
+		const auto os_xsave = (info[2] & (1 << 27)) != 0;
+		const auto avx = (info[2] & (1 << 28)) != 0;
+
+		// the OS saves the ymm registers
+		const auto ymm = os_xsave and avx and (_xgetbv(0) & 0x6) == 0x6;
+
+		auto avx2 = false;
+		if (max_leaf >= 7)
+		{
+			__cpuidex(info.data(), 7, 0);
+			avx2 = ymm and (info[1] & (1 << 5)) != 0;
+		}
+
+		return {.ssse3 = ssse3, .avx2 = avx2};
+#else
+		__builtin_cpu_init();
+
+		return {.ssse3 = __builtin_cpu_supports("ssse3") != 0, .avx2 = __builtin_cpu_supports("avx2") != 0};
+#endif
+	}
+#endif
+
+	[[nodiscard]] auto select_kernel() noexcept -> kernel_type
+	{
+#if PB_GRAPHICS_COLOR_BUFFER_X86
+		const auto features = cpu_features();
+
+		if (features.avx2)
+		{
+			return convert_avx2;
+		}
+
+		if (features.ssse3)
+		{
+			return convert_ssse3;
+		}
+#endif
+
+		return convert_scalar;
+	}
+
+#if PB_COMPILER_DEBUG
+	template<ColorFormat From, ColorFormat To>
+	[[nodiscard]] constexpr auto reference(const pixel_type pixel) noexcept -> pixel_type
+	{
+		return Color::from(pixel, color_format<From>).to(color_format<To>);
+	}
+
+	template<ColorFormat From>
+	[[nodiscard]] auto reference(const pixel_type pixel, const ColorFormat to) noexcept -> pixel_type
+	{
+		switch (to)
+		{
+			case ColorFormat::R_G_B:
+			{
+				return reference<From, ColorFormat::R_G_B>(pixel);
+			}
+			case ColorFormat::R_G_B_A:
+			{
+				return reference<From, ColorFormat::R_G_B_A>(pixel);
+			}
+			case ColorFormat::A_R_G_B:
+			{
+				return reference<From, ColorFormat::A_R_G_B>(pixel);
+			}
+			case ColorFormat::B_G_R:
+			{
+				return reference<From, ColorFormat::B_G_R>(pixel);
+			}
+			case ColorFormat::B_G_R_A:
+			{
+				return reference<From, ColorFormat::B_G_R_A>(pixel);
+			}
+			case ColorFormat::A_B_G_R:
+			{
+				return reference<From, ColorFormat::A_B_G_R>(pixel);
+			}
+		}
+
+		PB_COMPILER_UNREACHABLE();
+	}
+
+	[[nodiscard]] auto reference(const pixel_type pixel, const ColorFormat from, const ColorFormat to) noexcept -> pixel_type
+	{
+		switch (from)
+		{
+			case ColorFormat::R_G_B:
+			{
+				return reference<ColorFormat::R_G_B>(pixel, to);
+			}
+			case ColorFormat::R_G_B_A:
+			{
+				return reference<ColorFormat::R_G_B_A>(pixel, to);
+			}
+			case ColorFormat::A_R_G_B:
+			{
+				return reference<ColorFormat::A_R_G_B>(pixel, to);
+			}
+			case ColorFormat::B_G_R:
+			{
+				return reference<ColorFormat::B_G_R>(pixel, to);
+			}
+			case ColorFormat::B_G_R_A:
+			{
+				return reference<ColorFormat::B_G_R_A>(pixel, to);
+			}
+			case ColorFormat::A_B_G_R:
+			{
+				return reference<ColorFormat::A_B_G_R>(pixel, to);
+			}
+		}
+
+		PB_COMPILER_UNREACHABLE();
+	}
+
+	// the selected kernel gives the same result as `Color::from<from>(pixel).to<to>()` for every pair of formats
+	// (19 pixels, so that the 8/4 pixel bodies and the scalar tail all run)
+	[[nodiscard]] auto check_kernel(const kernel_type kernel) noexcept -> bool
+	{
+		constexpr std::array formats{
+				ColorFormat::R_G_B,
+				ColorFormat::R_G_B_A,
+				ColorFormat::A_R_G_B,
+				ColorFormat::B_G_R,
+				ColorFormat::B_G_R_A,
+				ColorFormat::A_B_G_R
+		};
+
+		std::array<pixel_type, 19> source{};
+		for (std::size_t i = 0; i < source.size(); ++i)
+		{
+			source[i] = static_cast<pixel_type>(0x0403'0201u * (i + 1) ^ 0x8040'2010u);
+		}
+
+		for (const auto from: formats)
+		{
+			for (const auto to: formats)
+			{
+				std::array<pixel_type, 19> destination{};
+				kernel(source.data(), destination.data(), source.size(), make_shuffle(from, to));
+
+				for (std::size_t i = 0; i < source.size(); ++i)
+				{
+					if (destination[i] != reference(source[i], from, to))
+					{
+						return false;
+					}
+				}
+			}
+		}
+
+		return true;
+	}
+#endif
+}
+
+namespace pb::infra::graphics
+{
+	auto convert(
+		const std::span<const universal_32_bit_color_type> source,
+		const ColorFormat from,
+		const ColorFormat to,
+		const std::span<universal_32_bit_color_type> destination
+	) noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(destination.size() >= source.size());
+		PB_ERROR_DEBUG_ASSUME(
+			source.data() == destination.data() or
+			source.data() + source.size() <= destination.data() or
+			destination.data() + source.size() <= source.data()
+		);
+
+		const auto shuffle = make_shuffle(from, to);
+
+		if (shuffle.identity())
+		{
+			if (source.data() != destination.data())
+			{
+				std::memcpy(destination.data(), source.data(), source.size_bytes());
+			}
+
+			return;
+		}
+
+		static const auto kernel = []() noexcept -> kernel_type
+		{
+			const auto selected = select_kernel();
+
+#if PB_COMPILER_DEBUG
+			PB_ERROR_DEBUG_ASSUME(check_kernel(selected), "the SIMD color conversion differs from Color::from/to");
+#endif
+
+			return selected;
+		}();
+
+		kernel(source.data(), destination.data(), source.size(), shuffle);
+	}
+}
@@ -0,0 +1,382 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <pb/graphics/color_lut.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <exception>
+#include <format>
+#include <fstream>
+#include <sstream>
+
+#include <pb/macro.hpp>
+#include <pb/platform/os.hpp>
+
+#if defined(__SSE2__) or defined(_M_X64) or (defined(_M_IX86_FP) and _M_IX86_FP >= 2)
+#define PB_GRAPHICS_COLOR_LUT_SSE2 1
+#include <emmintrin.h>
+#else
+#define PB_GRAPHICS_COLOR_LUT_SSE2 0
+#endif
+
+namespace
+{
+	using namespace pb::infra::graphics;
+
+	using value_type = ColorLUT::value_type;
+	using size_type = ColorLUT::size_type;
+	using entry_type = ColorLUT::entry_type;
+
+	// ============================================================
+	// .cube
+	// ============================================================
+
+	[[nodiscard]] constexpr auto is_space(const char c) noexcept -> bool
+	{
+		return c == ' ' or c == '\t' or c == '\r';
+	}
+
+	[[nodiscard]] constexpr auto trim(std::string_view string) noexcept -> std::string_view
+	{
+		while (not string.empty() and is_space(string.front()))
+		{
+			string.remove_prefix(1);
+		}
+		while (not string.empty() and is_space(string.back()))
+		{
+			string.remove_suffix(1);
+		}
+
+		return string;
+	}
+
+	// the next whitespace separated token of `string`, removed from it
+	[[nodiscard]] constexpr auto next_token(std::string_view& string) noexcept -> std::string_view
+	{
+		string = trim(string);
+
+		const auto end = std::ranges::find_if(string, is_space);
+		const auto length = static_cast<std::size_t>(end - string.begin());
+
+		const auto token = string.substr(0, length);
+		string.remove_prefix(length);
+
+		return token;
+	}
+
+	template<typename T>
+	[[nodiscard]] auto parse_number(const std::string_view token, T& value) noexcept -> bool
+	{
+		const auto* end = token.data() + token.size();
+		const auto [ptr, error] = std::from_chars(token.data(), end, value);
+
+		return error == std::errc{} and ptr == end;
+	}
+
+	// r g b
+	[[nodiscard]] auto parse_triplet(std::string_view string, entry_type& entry) noexcept -> bool
+	{
+		for (std::size_t i = 0; i < 3; ++i)
+		{
+			if (not parse_number(next_token(string), entry[i]))
+			{
+				return false;
+			}
+		}
+		entry[3] = 0;
+
+		return trim(string).empty();
+	}
+
+	// ============================================================
+	// GRADING
+	// ============================================================
+
+	[[nodiscard]] auto to_byte(const value_type value) noexcept -> Color::value_type
+	{
+		return static_cast<Color::value_type>(std::ranges::clamp(value, value_type{0}, value_type{1}) * 255.f + .5f);
+	}
+}
+
+namespace pb::infra::graphics
+{
+	auto ColorLUT::build_axes(const entry_type& domain_min, const entry_type& domain_max) noexcept -> void
+	{
+		const auto max_index = static_cast<value_type>(size_ - 1);
+
+		for (std::size_t axis = 0; axis < 3; ++axis)
+		{
+			const auto stride = axis == 0 ? 1 : (axis == 1 ? size_ : size_ * size_);
+			const auto low = domain_min[axis];
+			const auto range = domain_max[axis] - low;
+
+			for (std::size_t value = 0; value < 256; ++value)
+			{
+				// input => domain => lattice
+				const auto normalized = std::ranges::clamp((static_cast<value_type>(value) / 255.f - low) / range, value_type{0}, value_type{1});
+				const auto position = normalized * max_index;
+
+				// the last cell is [size - 2, size - 1], so that the upper corner is always inside the table
+				const auto index = std::ranges::min(static_cast<size_type>(position), size_ - 2);
+
+				axes_[axis][value] = {.offset = index * stride, .fraction = position - static_cast<value_type>(index)};
+			}
+		}
+	}
+
+	ColorLUT::ColorLUT(const size_type size, std::vector<entry_type> entries, const entry_type& domain_min, const entry_type& domain_max)
+		: size_{size},
+		  entries_{std::move(entries)},
+		  axes_{}
+	{
+		if (size_ < min_size or size_ > max_size)
+		{
+			ColorLUTError::panic(std::format("LUT size must be in [{}, {}], got {}", min_size, max_size, size_));
+		}
+
+		if (entries_.size() != static_cast<std::size_t>(size_) * size_ * size_)
+		{
+			ColorLUTError::panic(std::format("LUT of size {} needs {} entries, got {}", size_, static_cast<std::size_t>(size_) * size_ * size_, entries_.size()));
+		}
+
+		for (std::size_t axis = 0; axis < 3; ++axis)
+		{
+			if (not(domain_max[axis] > domain_min[axis]))
+			{
+				ColorLUTError::panic(std::format("LUT domain is empty on axis {}", axis));
+			}
+		}
+
+		build_axes(domain_min, domain_max);
+	}
+
+	auto ColorLUT::identity(const size_type size) -> ColorLUT
+	{
+		std::vector<entry_type> entries{};
+		entries.reserve(static_cast<std::size_t>(size) * size * size);
+
+		const auto scale = 1.f / static_cast<value_type>(size - 1);
+		for (size_type b = 0; b < size; ++b)
+		{
+			for (size_type g = 0; g < size; ++g)
+			{
+				for (size_type r = 0; r < size; ++r)
+				{
+					entries.push_back({static_cast<value_type>(r) * scale, static_cast<value_type>(g) * scale, static_cast<value_type>(b) * scale, 0});
+				}
+			}
+		}
+
+		return {size, std::move(entries)};
+	}
+
+	auto ColorLUT::from_cube(const std::string_view content) -> ColorLUT
+	{
+		size_type size = 0;
+		entry_type domain_min{0, 0, 0, 0};
+		entry_type domain_max{1, 1, 1, 0};
+		std::vector<entry_type> entries{};
+
+		std::size_t line_number = 0;
+		for (std::size_t begin = 0; begin < content.size();)
+		{
+			auto end = content.find('\n', begin);
+			if (end == std::string_view::npos)
+			{
+				end = content.size();
+			}
+
+			line_number += 1;
+			auto line = trim(content.substr(begin, end - begin));
+			begin = end + 1;
+
+			if (line.empty() or line.starts_with('#'))
+			{
+				continue;
+			}
+
+			// data line
+			if (const auto first = line.front();
+				(first >= '0' and first <= '9') or first == '-' or first == '+' or first == '.')
+			{
+				if (size == 0)
+				{
+					ColorLUTError::panic(std::format("line {}: data before LUT_3D_SIZE", line_number));
+				}
+
+				entry_type entry;
+				if (not parse_triplet(line, entry))
+				{
+					ColorLUTError::panic(std::format("line {}: expected 3 numbers", line_number));
+				}
+
+				entries.push_back(entry);
+				continue;
+			}
+
+			const auto keyword = next_token(line);
+			if (keyword == "TITLE")
+			{
+				continue;
+			}
+
+			if (keyword == "LUT_3D_SIZE")
+			{
+				if (not parse_number(next_token(line), size) or size < min_size or size > max_size)
+				{
+					ColorLUTError::panic(std::format("line {}: LUT_3D_SIZE must be in [{}, {}]", line_number, min_size, max_size));
+				}
+
+				entries.reserve(static_cast<std::size_t>(size) * size * size);
+				continue;
+			}
+
+			if (keyword == "DOMAIN_MIN" or keyword == "DOMAIN_MAX")
+			{
+				if (not parse_triplet(line, keyword == "DOMAIN_MIN" ? domain_min : domain_max))
+				{
+					ColorLUTError::panic(std::format("line {}: expected 3 numbers after {}", line_number, keyword));
+				}
+
+				continue;
+			}
+
+			if (keyword == "LUT_1D_SIZE" or keyword == "LUT_1D_INPUT_RANGE")
+			{
+				ColorLUTError::panic(std::format("line {}: 1D LUTs are not supported", line_number));
+			}
+
+			if (keyword == "LUT_3D_INPUT_RANGE")
+			{
+				entry_type range;
+				if (std::string_view rest = line;
+					not parse_number(next_token(rest), range[0]) or not parse_number(next_token(rest), range[1]) or not trim(rest).empty())
+				{
+					ColorLUTError::panic(std::format("line {}: expected 2 numbers after LUT_3D_INPUT_RANGE", line_number));
+				}
+
+				domain_min = {range[0], range[0], range[0], 0};
+				domain_max = {range[1], range[1], range[1], 0};
+				continue;
+			}
+
+			ColorLUTError::panic(std::format("line {}: unknown keyword '{}'", line_number, keyword));
+		}
+
+		if (size == 0)
+		{
+			ColorLUTError::panic("missing LUT_3D_SIZE");
+		}
+
+		return {size, std::move(entries), domain_min, domain_max};
+	}
+
+	auto ColorLUT::from_cube_file(const std::filesystem::path& path) -> ColorLUT
+	{
+		std::ifstream file{path, std::ios::binary};
+		if (not file.is_open())
+		{
+			ColorLUTError::panic(std::format("cannot open '{}'", path.string()));
+		}
+
+		std::ostringstream content{};
+		content << file.rdbuf();
+
+		return from_cube(content.view());
+	}
+
+	auto ColorLUT::size() const noexcept -> size_type
+	{
+		return size_;
+	}
+
+	auto ColorLUT::entries() const noexcept -> std::span<const entry_type>
+	{
+		return entries_;
+	}
+
+	auto ColorLUT::apply(const Color& color) const noexcept -> Color
+	{
+		const auto& r = axes_[0][color.red];
+		const auto& g = axes_[1][color.green];
+		const auto& b = axes_[2][color.blue];
+
+		const auto* base = entries_.data() + (r.offset + g.offset + b.offset);
+		const auto stride_g = static_cast<std::size_t>(size_);
+		const auto stride_b = static_cast<std::size_t>(size_) * size_;
+
+#if PB_GRAPHICS_COLOR_LUT_SSE2
+		const auto load = [](const entry_type* entry) noexcept -> __m128
+		{
+			return _mm_loadu_ps(entry->data());
+		};
+
+		// ReSharper disable once IdentifierTypo
+		const auto lerp = [](const __m128 a, const __m128 b, const __m128 t) noexcept -> __m128
+		{
+			return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t));
+		};
+
+		const auto fr = _mm_set1_ps(r.fraction);
+		const auto fg = _mm_set1_ps(g.fraction);
+		const auto fb = _mm_set1_ps(b.fraction);
+
+		const auto c00 = lerp(load(base), load(base + 1), fr);
+		const auto c10 = lerp(load(base + stride_g), load(base + stride_g + 1), fr);
+		const auto c01 = lerp(load(base + stride_b), load(base + stride_b + 1), fr);
+		const auto c11 = lerp(load(base + stride_g + stride_b), load(base + stride_g + stride_b + 1), fr);
+
+		const auto c0 = lerp(c00, c10, fg);
+		const auto c1 = lerp(c01, c11, fg);
+
+		const auto result = lerp(c0, c1, fb);
+
+		alignas(16) entry_type channels;
+		_mm_store_ps(channels.data(), result);
+#else
+		// ReSharper disable once IdentifierTypo
+		const auto lerp = [](const entry_type& a, const entry_type& b, const value_type t) noexcept -> entry_type
+		{
+			return {a[0] + (b[0] - a[0]) * t, a[1] + (b[1] - a[1]) * t, a[2] + (b[2] - a[2]) * t, 0};
+		};
+
+		const auto c00 = lerp(base[0], base[1], r.fraction);
+		const auto c10 = lerp(base[stride_g], base[stride_g + 1], r.fraction);
+		const auto c01 = lerp(base[stride_b], base[stride_b + 1], r.fraction);
+		const auto c11 = lerp(base[stride_g + stride_b], base[stride_g + stride_b + 1], r.fraction);
+
+		const auto c0 = lerp(c00, c10, g.fraction);
+		const auto c1 = lerp(c01, c11, g.fraction);
+
+		const auto channels = lerp(c0, c1, b.fraction);
+#endif
+
+		return {.red = to_byte(channels[0]), .green = to_byte(channels[1]), .blue = to_byte(channels[2]), .alpha = color.alpha};
+	}
+
+	auto ColorLUT::apply(const std::span<const Color> source, const std::span<Color> destination) const noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(destination.size() >= source.size());
+
+		for (std::size_t i = 0; i < source.size(); ++i)
+		{
+			destination[i] = apply(source[i]);
+		}
+	}
+
+	auto ColorLUT::apply(const SurfaceView& surface, const std::uint32_t row_begin, const std::uint32_t row_end) const noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(row_begin <= row_end and row_end <= surface.height);
+		PB_ERROR_DEBUG_ASSUME(surface.pitch >= surface.width);
+
+		for (auto row = row_begin; row < row_end; ++row)
+		{
+			const std::span pixels{surface.pixels + static_cast<std::size_t>(row) * surface.pitch, surface.width};
+
+			apply(pixels, pixels);
+		}
+	}
+}
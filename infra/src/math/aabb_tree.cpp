@@ -0,0 +1,408 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <pb/math/aabb_tree.hpp>
+
+#include <algorithm>
+#include <utility>
+
+#include <pb/macro.hpp>
+#include <pb/platform/os.hpp>
+
+namespace pb::math
+{
+	AABBTree::AABBTree(const value_type margin, const value_type displacement_multiplier) noexcept
+		: root_{null_proxy},
+		  free_list_{null_proxy},
+		  margin_{margin},
+		  displacement_multiplier_{displacement_multiplier} {}
+
+	auto AABBTree::allocate_node() -> proxy_type
+	{
+		if (free_list_ == null_proxy)
+		{
+			const auto index = static_cast<proxy_type>(nodes_.size());
+			nodes_.emplace_back(
+				node_type{
+						.aabb = {},
+						.user_data = 0,
+						.parent = null_proxy,
+						.child_1 = null_proxy,
+						.child_2 = null_proxy,
+						.height = 0,
+						.leaf_index = 0
+				}
+			);
+
+			return index;
+		}
+
+		const auto index = free_list_;
+		auto& node = nodes_[index];
+
+		free_list_ = node.parent;
+
+		node.parent = null_proxy;
+		node.child_1 = null_proxy;
+		node.child_2 = null_proxy;
+		node.height = 0;
+
+		return index;
+	}
+
+	auto AABBTree::free_node(const proxy_type node) noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(node < nodes_.size());
+
+		nodes_[node].parent = free_list_;
+		nodes_[node].height = -1;
+		free_list_ = node;
+	}
+
+	auto AABBTree::insert_leaf(const proxy_type leaf, const proxy_type parent) noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME((root_ == null_proxy) == (parent == null_proxy));
+
+		if (root_ == null_proxy)
+		{
+			root_ = leaf;
+			nodes_[leaf].parent = null_proxy;
+			return;
+		}
+
+		// find the best sibling, minimizing the surface area (perimeter in 2D) added to the tree
+		const auto leaf_aabb = nodes_[leaf].aabb;
+
+		auto index = root_;
+		while (not nodes_[index].is_leaf())
+		{
+			const auto& node = nodes_[index];
+
+			const auto area = node.aabb.perimeter();
+			const auto combined_area = node.aabb.merge(leaf_aabb).perimeter();
+
+			// cost of creating a new parent for this node and the new leaf
+			const auto cost = 2.f * combined_area;
+			// minimum cost of pushing the leaf further down the tree
+			const auto inheritance_cost = 2.f * (combined_area - area);
+
+			const auto cost_of = [&](const proxy_type child) noexcept -> value_type
+			{
+				const auto& c = nodes_[child];
+				const auto merged = leaf_aabb.merge(c.aabb).perimeter();
+
+				if (c.is_leaf())
+				{
+					return merged + inheritance_cost;
+				}
+				return (merged - c.aabb.perimeter()) + inheritance_cost;
+			};
+
+			const auto cost_1 = cost_of(node.child_1);
+			const auto cost_2 = cost_of(node.child_2);
+
+			if (cost < cost_1 and cost < cost_2)
+			{
+				break;
+			}
+
+			index = cost_1 < cost_2 ? node.child_1 : node.child_2;
+		}
+
+		const auto sibling = index;
+
+		// new parent of the leaf and the sibling
+		const auto old_parent = nodes_[sibling].parent;
+		const auto new_parent = parent;
+		{
+			auto& node = nodes_[new_parent];
+			node.parent = old_parent;
+			node.user_data = 0;
+			node.aabb = leaf_aabb.merge(nodes_[sibling].aabb);
+			node.height = nodes_[sibling].height + 1;
+			node.child_1 = sibling;
+			node.child_2 = leaf;
+		}
+
+		if (old_parent != null_proxy)
+		{
+			auto& parent = nodes_[old_parent];
+			if (parent.child_1 == sibling)
+			{
+				parent.child_1 = new_parent;
+			}
+			else
+			{
+				parent.child_2 = new_parent;
+			}
+		}
+		else
+		{
+			root_ = new_parent;
+		}
+
+		nodes_[sibling].parent = new_parent;
+		nodes_[leaf].parent = new_parent;
+
+		refit(nodes_[leaf].parent);
+	}
+
+	auto AABBTree::remove_leaf(const proxy_type leaf) noexcept -> proxy_type
+	{
+		if (leaf == root_)
+		{
+			root_ = null_proxy;
+			return null_proxy;
+		}
+
+		const auto parent = nodes_[leaf].parent;
+		const auto grand_parent = nodes_[parent].parent;
+		const auto sibling = nodes_[parent].child_1 == leaf ? nodes_[parent].child_2 : nodes_[parent].child_1;
+
+		if (grand_parent == null_proxy)
+		{
+			root_ = sibling;
+			nodes_[sibling].parent = null_proxy;
+			return parent;
+		}
+
+		// replace the parent by the sibling
+		if (auto& node = nodes_[grand_parent];
+			node.child_1 == parent)
+		{
+			node.child_1 = sibling;
+		}
+		else
+		{
+			node.child_2 = sibling;
+		}
+		nodes_[sibling].parent = grand_parent;
+
+		refit(grand_parent);
+		return parent;
+	}
+
+	auto AABBTree::refit(proxy_type node) noexcept -> void
+	{
+		while (node != null_proxy)
+		{
+			node = balance(node);
+
+			auto& n = nodes_[node];
+			const auto& c1 = nodes_[n.child_1];
+			const auto& c2 = nodes_[n.child_2];
+
+			n.height = 1 + std::ranges::max(c1.height, c2.height);
+			n.aabb = c1.aabb.merge(c2.aabb);
+
+			node = n.parent;
+		}
+	}
+
+	auto AABBTree::balance(const proxy_type node) noexcept -> proxy_type
+	{
+		// A has children B (D, E) and C (F, G)
+		// if C is two levels higher than B, C becomes the root of the subtree, A takes the place of C and adopts its lower child
+		// (and symmetrically for B)
+
+		const auto a = node;
+		auto& node_a = nodes_[a];
+
+		if (node_a.is_leaf() or node_a.height < 2)
+		{
+			return a;
+		}
+
+		const auto b = node_a.child_1;
+		const auto c = node_a.child_2;
+
+		const auto rotate = [this, a](const proxy_type up, const proxy_type down, const bool up_is_child_2) noexcept -> proxy_type
+		{
+			auto& node_a = nodes_[a];
+			auto& node_up = nodes_[up];
+			auto& node_down = nodes_[down];
+
+			const auto f = node_up.child_1;
+			const auto g = node_up.child_2;
+			auto& node_f = nodes_[f];
+			auto& node_g = nodes_[g];
+
+			// up becomes the parent of a
+			node_up.child_1 = a;
+			node_up.parent = node_a.parent;
+			node_a.parent = up;
+
+			if (node_up.parent != null_proxy)
+			{
+				if (auto& parent = nodes_[node_up.parent];
+					parent.child_1 == a)
+				{
+					parent.child_1 = up;
+				}
+				else
+				{
+					parent.child_2 = up;
+				}
+			}
+			else
+			{
+				root_ = up;
+			}
+
+			// the higher child of up stays, the lower one moves to a
+			const auto [keep, give] = node_f.height > node_g.height ? std::pair{f, g} : std::pair{g, f};
+
+			node_up.child_2 = keep;
+			if (up_is_child_2)
+			{
+				node_a.child_2 = give;
+			}
+			else
+			{
+				node_a.child_1 = give;
+			}
+			nodes_[give].parent = a;
+
+			node_a.aabb = node_down.aabb.merge(nodes_[give].aabb);
+			node_up.aabb = node_a.aabb.merge(nodes_[keep].aabb);
+
+			node_a.height = 1 + std::ranges::max(node_down.height, nodes_[give].height);
+			node_up.height = 1 + std::ranges::max(node_a.height, nodes_[keep].height);
+
+			return up;
+		};
+
+		const auto balance_factor = nodes_[c].height - nodes_[b].height;
+
+		// rotate C up
+		if (balance_factor > 1)
+		{
+			return rotate(c, b, true);
+		}
+
+		// rotate B up
+		if (balance_factor < -1)
+		{
+			return rotate(b, c, false);
+		}
+
+		return a;
+	}
+
+	auto AABBTree::create_proxy(const AABB& aabb, const user_data_type user_data) -> proxy_type
+	{
+		const auto proxy = allocate_node();
+		// allocated here so that inserting the leaf cannot fail
+		proxy_type parent = null_proxy;
+		try
+		{
+			if (root_ != null_proxy)
+			{
+				parent = allocate_node();
+			}
+
+			leaves_.push_back(proxy);
+		}
+		catch (...)
+		{
+			// neither node is linked yet, give them back
+			if (parent != null_proxy)
+			{
+				free_node(parent);
+			}
+			free_node(proxy);
+			throw;
+		}
+
+		auto& node = nodes_[proxy];
+		node.aabb = aabb.fatten(margin_);
+		node.user_data = user_data;
+		node.height = 0;
+		node.leaf_index = static_cast<std::uint32_t>(leaves_.size() - 1);
+
+		insert_leaf(proxy, parent);
+		return proxy;
+	}
+
+	auto AABBTree::destroy_proxy(const proxy_type proxy) noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(proxy < nodes_.size() and nodes_[proxy].is_leaf() and nodes_[proxy].height == 0);
+
+		if (const auto parent = remove_leaf(proxy);
+			parent != null_proxy)
+		{
+			free_node(parent);
+		}
+
+		// swap-remove from the leaf list
+		const auto leaf_index = nodes_[proxy].leaf_index;
+		const auto last = leaves_.back();
+		leaves_[leaf_index] = last;
+		nodes_[last].leaf_index = leaf_index;
+		leaves_.pop_back();
+
+		free_node(proxy);
+	}
+
+	auto AABBTree::move_proxy(const proxy_type proxy, const AABB& aabb, const glm::vec2& displacement) noexcept -> bool
+	{
+		PB_ERROR_DEBUG_ASSUME(proxy < nodes_.size() and nodes_[proxy].is_leaf() and nodes_[proxy].height == 0);
+
+		if (nodes_[proxy].aabb.contains(aabb))
+		{
+			return false;
+		}
+
+		// the former parent is reused, the tree has the same shape (empty or not) once the leaf is removed
+		const auto parent = remove_leaf(proxy);
+
+		nodes_[proxy].aabb = aabb.fatten(margin_).extend(displacement * displacement_multiplier_);
+
+		insert_leaf(proxy, parent);
+		return true;
+	}
+
+	auto AABBTree::user_data_of(const proxy_type proxy) const noexcept -> user_data_type
+	{
+		PB_ERROR_DEBUG_ASSUME(proxy < nodes_.size());
+
+		return nodes_[proxy].user_data;
+	}
+
+	auto AABBTree::fat_aabb_of(const proxy_type proxy) const noexcept -> const AABB&
+	{
+		PB_ERROR_DEBUG_ASSUME(proxy < nodes_.size());
+
+		return nodes_[proxy].aabb;
+	}
+
+	auto AABBTree::proxies() const noexcept -> std::span<const proxy_type>
+	{
+		return leaves_;
+	}
+
+	auto AABBTree::size() const noexcept -> std::size_t
+	{
+		return leaves_.size();
+	}
+
+	auto AABBTree::height() const noexcept -> std::int32_t
+	{
+		if (root_ == null_proxy)
+		{
+			return 0;
+		}
+
+		return nodes_[root_].height;
+	}
+
+	auto AABBTree::clear() noexcept -> void
+	{
+		nodes_.clear();
+		leaves_.clear();
+		root_ = null_proxy;
+		free_list_ = null_proxy;
+	}
+}
@@ -0,0 +1,561 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <pb/math/angle_batch.hpp>
+
+#include <type_traits>
+
+#include <pb/macro.hpp>
+#include <pb/platform/os.hpp>
+
+#if defined(__SSE2__) or defined(_M_X64) or (defined(_M_IX86_FP) and _M_IX86_FP >= 2)
+#define PB_MATH_ANGLE_BATCH_SSE2 1
+#include <emmintrin.h>
+#else
+#define PB_MATH_ANGLE_BATCH_SSE2 0
+#endif
+
+namespace
+{
+	using namespace pb::math;
+
+	using value_type = AngleBatch::value_type;
+	using size_type = AngleBatch::size_type;
+
+	// `Angle` is a single float, a span of angles is accessed as an array of degrees
+	static_assert(sizeof(Angle) == sizeof(value_type) and std::is_standard_layout_v<Angle>);
+	static_assert(sizeof(glm::vec2) == sizeof(value_type) * 2);
+
+	[[nodiscard]] auto degrees_of(const std::span<const Angle> angles) noexcept -> const value_type*
+	{
+		return reinterpret_cast<const value_type*>(angles.data());
+	}
+
+	[[nodiscard]] auto degrees_of(const std::span<Angle> angles) noexcept -> value_type*
+	{
+		return reinterpret_cast<value_type*>(angles.data());
+	}
+
+	[[nodiscard]] auto floats_of(const std::span<const glm::vec2> points) noexcept -> const value_type*
+	{
+		return reinterpret_cast<const value_type*>(points.data());
+	}
+
+	[[nodiscard]] auto floats_of(const std::span<glm::vec2> points) noexcept -> value_type*
+	{
+		return reinterpret_cast<value_type*>(points.data());
+	}
+
+#if PB_MATH_ANGLE_BATCH_SSE2
+	constexpr size_type width = 4;
+
+	[[nodiscard]] auto abs_ps(const __m128 x) noexcept -> __m128
+	{
+		return _mm_andnot_ps(_mm_set1_ps(-0.f), x);
+	}
+
+	// mask ? a : b
+	[[nodiscard]] auto select_ps(const __m128 mask, const __m128 a, const __m128 b) noexcept -> __m128
+	{
+		return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+	}
+
+	// |x| < 2^31
+	[[nodiscard]] auto floor_ps(const __m128 x) noexcept -> __m128
+	{
+		const auto truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+		return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, x), _mm_set1_ps(1.f)));
+	}
+
+	// glm::mod
+	[[nodiscard]] auto mod_ps(const __m128 x, const value_type y) noexcept -> __m128
+	{
+		const auto vy = _mm_set1_ps(y);
+		return _mm_sub_ps(x, _mm_mul_ps(vy, floor_ps(_mm_div_ps(x, vy))));
+	}
+
+	// see `angle_batch_detail::sin_polynomial`
+	[[nodiscard]] auto sin_polynomial_ps(const __m128 x) noexcept -> __m128
+	{
+		const auto x2 = _mm_mul_ps(x, x);
+
+		auto p = _mm_set1_ps(1.f / 362880);
+		p = _mm_add_ps(_mm_set1_ps(-1.f / 5040), _mm_mul_ps(x2, p));
+		p = _mm_add_ps(_mm_set1_ps(1.f / 120), _mm_mul_ps(x2, p));
+		p = _mm_add_ps(_mm_set1_ps(-1.f / 6), _mm_mul_ps(x2, p));
+
+		return _mm_add_ps(x, _mm_mul_ps(_mm_mul_ps(x, x2), p));
+	}
+
+	// see `angle_batch_detail::cos_polynomial`
+	[[nodiscard]] auto cos_polynomial_ps(const __m128 x) noexcept -> __m128
+	{
+		const auto x2 = _mm_mul_ps(x, x);
+
+		auto p = _mm_set1_ps(1.f / 40320);
+		p = _mm_add_ps(_mm_set1_ps(-1.f / 720), _mm_mul_ps(x2, p));
+		p = _mm_add_ps(_mm_set1_ps(1.f / 24), _mm_mul_ps(x2, p));
+		p = _mm_add_ps(_mm_set1_ps(-1.f / 2), _mm_mul_ps(x2, p));
+
+		return _mm_add_ps(_mm_set1_ps(1.f), _mm_mul_ps(x2, p));
+	}
+
+	// see `angle_batch_detail::atan_polynomial`
+	[[nodiscard]] auto atan_polynomial_ps(const __m128 x) noexcept -> __m128
+	{
+		const auto x2 = _mm_mul_ps(x, x);
+
+		auto p = _mm_set1_ps(0.0028662257f);
+		p = _mm_add_ps(_mm_set1_ps(-0.0161657367f), _mm_mul_ps(x2, p));
+		p = _mm_add_ps(_mm_set1_ps(0.0429096138f), _mm_mul_ps(x2, p));
+		p = _mm_add_ps(_mm_set1_ps(-0.0752896400f), _mm_mul_ps(x2, p));
+		p = _mm_add_ps(_mm_set1_ps(0.1065626393f), _mm_mul_ps(x2, p));
+		p = _mm_add_ps(_mm_set1_ps(-0.1420889944f), _mm_mul_ps(x2, p));
+		p = _mm_add_ps(_mm_set1_ps(0.1999355085f), _mm_mul_ps(x2, p));
+		p = _mm_add_ps(_mm_set1_ps(-0.3333314528f), _mm_mul_ps(x2, p));
+		p = _mm_add_ps(_mm_set1_ps(1.f), _mm_mul_ps(x2, p));
+
+		return _mm_mul_ps(x, p);
+	}
+
+	// see `angle_batch_detail::sincos`
+	auto sincos_ps(const __m128 degrees, __m128& out_sin, __m128& out_cos) noexcept -> void
+	{
+		// static_cast<std::int32_t>(degrees / 90 +- .5), same rounding as the scalar version
+		const auto half = _mm_or_ps(_mm_set1_ps(.5f), _mm_and_ps(degrees, _mm_set1_ps(-0.f)));
+		const auto quadrant = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(degrees, _mm_set1_ps(1.f / 90.f)), half));
+
+		const auto x = _mm_mul_ps(
+			_mm_sub_ps(degrees, _mm_mul_ps(_mm_cvtepi32_ps(quadrant), _mm_set1_ps(90.f))),
+			_mm_set1_ps(Angle::degrees_to_radians)
+		);
+
+		const auto s = sin_polynomial_ps(x);
+		const auto c = cos_polynomial_ps(x);
+
+		// quadrant & 1 => swap
+		const auto swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+		// quadrant & 2 => -sin, (quadrant + 1) & 2 => -cos
+		const auto sin_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(2)), 30));
+		const auto cos_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+
+		out_sin = _mm_xor_ps(select_ps(swap, c, s), sin_sign);
+		out_cos = _mm_xor_ps(select_ps(swap, s, c), cos_sign);
+	}
+
+	// see `angle_batch_detail::atan2`
+	[[nodiscard]] auto atan2_ps(const __m128 y, const __m128 x) noexcept -> __m128
+	{
+		const auto zero = _mm_setzero_ps();
+
+		const auto abs_x = abs_ps(x);
+		const auto abs_y = abs_ps(y);
+
+		const auto max = _mm_max_ps(abs_x, abs_y);
+		const auto min = _mm_min_ps(abs_x, abs_y);
+
+		const auto max_is_zero = _mm_cmpeq_ps(max, zero);
+		// 0 / 0 is masked out below
+		const auto ratio = _mm_div_ps(min, _mm_or_ps(max, _mm_and_ps(max_is_zero, _mm_set1_ps(1.f))));
+
+		auto radians = atan_polynomial_ps(ratio);
+		radians = select_ps(_mm_cmpgt_ps(abs_y, abs_x), _mm_sub_ps(_mm_set1_ps(angle_batch_detail::half_pi), radians), radians);
+		radians = select_ps(_mm_cmplt_ps(x, zero), _mm_sub_ps(_mm_set1_ps(angle_batch_detail::pi), radians), radians);
+		radians = select_ps(_mm_cmplt_ps(y, zero), _mm_sub_ps(zero, radians), radians);
+
+		return radians;
+	}
+
+	// [x0, y0, x1, y1], [x2, y2, x3, y3] => [x0, x1, x2, x3], [y0, y1, y2, y3]
+	auto load_points(const value_type* points, __m128& x, __m128& y) noexcept -> void
+	{
+		const auto low = _mm_loadu_ps(points);
+		const auto high = _mm_loadu_ps(points + width);
+
+		x = _mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0));
+		y = _mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1));
+	}
+
+	// [x0, x1, x2, x3], [y0, y1, y2, y3] => [x0, y0, x1, y1], [x2, y2, x3, y3]
+	auto store_points(value_type* points, const __m128 x, const __m128 y) noexcept -> void
+	{
+		_mm_storeu_ps(points, _mm_unpacklo_ps(x, y));
+		_mm_storeu_ps(points + width, _mm_unpackhi_ps(x, y));
+	}
+
+	// see `Angle::shortest_distance` and the direction of `Angle::move_toward` / `Angle::lerp`
+	auto shortest_distance_ps(const __m128 from, const __m128 to, __m128& out_distance, __m128& out_direction) noexcept -> void
+	{
+		const auto diff = abs_ps(_mm_sub_ps(from, to));
+		out_distance = _mm_min_ps(diff, _mm_sub_ps(_mm_set1_ps(360.f), diff));
+
+		const auto signed_diff = _mm_sub_ps(mod_ps(_mm_add_ps(_mm_sub_ps(to, from), _mm_set1_ps(180.f)), 360.f), _mm_set1_ps(180.f));
+		out_direction = select_ps(_mm_cmpge_ps(signed_diff, _mm_setzero_ps()), _mm_set1_ps(1.f), _mm_set1_ps(-1.f));
+	}
+#else
+	constexpr size_type width = 1;
+#endif
+
+	// the SIMD body handles [0, simd_size(size)), the scalar tail handles the rest
+	[[nodiscard]] constexpr auto simd_size(const size_type size) noexcept -> size_type
+	{
+		return size - size % width;
+	}
+}
+
+namespace pb::math
+{
+	auto AngleBatch::from_position(const std::span<const glm::vec2> from, const std::span<const glm::vec2> to) const noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(from.size() >= size());
+		PB_ERROR_DEBUG_ASSUME(to.size() >= size());
+
+		auto* out = degrees_of(angles_);
+		size_type i = 0;
+
+#if PB_MATH_ANGLE_BATCH_SSE2
+		const auto* f = floats_of(from);
+		const auto* t = floats_of(to);
+
+		for (; i < simd_size(size()); i += width)
+		{
+			__m128 from_x, from_y, to_x, to_y;
+			load_points(f + i * 2, from_x, from_y);
+			load_points(t + i * 2, to_x, to_y);
+
+			auto degrees = _mm_mul_ps(atan2_ps(_mm_sub_ps(to_y, from_y), _mm_sub_ps(to_x, from_x)), _mm_set1_ps(Angle::radians_to_degrees));
+			degrees = _mm_add_ps(degrees, _mm_and_ps(_mm_cmplt_ps(degrees, _mm_setzero_ps()), _mm_set1_ps(360.f)));
+
+			_mm_storeu_ps(out + i, degrees);
+		}
+#endif
+
+		for (; i < size(); ++i)
+		{
+			const auto delta = to[i] - from[i];
+
+			auto degrees = angle_batch_detail::atan2(delta.y, delta.x) * Angle::radians_to_degrees;
+			if (degrees < 0)
+			{
+				degrees += 360.f;
+			}
+
+			out[i] = degrees;
+		}
+	}
+
+	auto AngleBatch::from_position(const std::span<const glm::vec2> to) const noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(to.size() >= size());
+
+		auto* out = degrees_of(angles_);
+		size_type i = 0;
+
+#if PB_MATH_ANGLE_BATCH_SSE2
+		const auto* t = floats_of(to);
+
+		for (; i < simd_size(size()); i += width)
+		{
+			__m128 to_x, to_y;
+			load_points(t + i * 2, to_x, to_y);
+
+			auto degrees = _mm_mul_ps(atan2_ps(to_y, to_x), _mm_set1_ps(Angle::radians_to_degrees));
+			degrees = _mm_add_ps(degrees, _mm_and_ps(_mm_cmplt_ps(degrees, _mm_setzero_ps()), _mm_set1_ps(360.f)));
+
+			_mm_storeu_ps(out + i, degrees);
+		}
+#endif
+
+		for (; i < size(); ++i)
+		{
+			auto degrees = angle_batch_detail::atan2(to[i].y, to[i].x) * Angle::radians_to_degrees;
+			if (degrees < 0)
+			{
+				degrees += 360.f;
+			}
+
+			out[i] = degrees;
+		}
+	}
+
+	auto AngleBatch::from_direction(const std::span<const glm::vec2> direction) const noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(direction.size() >= size());
+
+		auto* out = degrees_of(angles_);
+		size_type i = 0;
+
+#if PB_MATH_ANGLE_BATCH_SSE2
+		const auto* d = floats_of(direction);
+
+		for (; i < simd_size(size()); i += width)
+		{
+			__m128 x, y;
+			load_points(d + i * 2, x, y);
+
+			// NOTE: atan(x, y), see `Angle::from_direction`
+			_mm_storeu_ps(out + i, _mm_mul_ps(atan2_ps(x, y), _mm_set1_ps(Angle::radians_to_degrees)));
+		}
+#endif
+
+		for (; i < size(); ++i)
+		{
+			out[i] = angle_batch_detail::atan2(direction[i].x, direction[i].y) * Angle::radians_to_degrees;
+		}
+	}
+
+	auto AngleBatch::normalize() const noexcept -> void
+	{
+		size_type i = 0;
+
+#if PB_MATH_ANGLE_BATCH_SSE2
+		auto* degrees = degrees_of(angles_);
+
+		for (; i < simd_size(size()); i += width)
+		{
+			_mm_storeu_ps(degrees + i, mod_ps(_mm_loadu_ps(degrees + i), 360.f));
+		}
+#endif
+
+		for (; i < size(); ++i)
+		{
+			angles_[i] = angles_[i].to_normalized();
+		}
+	}
+
+	auto AngleBatch::move_toward(const std::span<const Angle> target, const value_type speed) const noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(target.size() >= size());
+
+		size_type i = 0;
+
+#if PB_MATH_ANGLE_BATCH_SSE2
+		auto* degrees = degrees_of(angles_);
+		const auto* target_degrees = degrees_of(target);
+
+		const auto v_speed = _mm_set1_ps(speed);
+
+		for (; i < simd_size(size()); i += width)
+		{
+			const auto from = _mm_loadu_ps(degrees + i);
+			const auto to = _mm_loadu_ps(target_degrees + i);
+
+			__m128 distance, direction;
+			shortest_distance_ps(from, to, distance, direction);
+
+			const auto moved = _mm_add_ps(from, _mm_mul_ps(direction, v_speed));
+			_mm_storeu_ps(degrees + i, select_ps(_mm_cmplt_ps(distance, v_speed), to, moved));
+		}
+#endif
+
+		for (; i < size(); ++i)
+		{
+			angles_[i] = angles_[i].move_toward(target[i], speed);
+		}
+	}
+
+	auto AngleBatch::lerp(const std::span<const Angle> dest, const value_type t) const noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(dest.size() >= size());
+
+		size_type i = 0;
+
+#if PB_MATH_ANGLE_BATCH_SSE2
+		auto* degrees = degrees_of(angles_);
+		const auto* dest_degrees = degrees_of(dest);
+
+		const auto v_t = _mm_set1_ps(t);
+
+		for (; i < simd_size(size()); i += width)
+		{
+			const auto from = _mm_loadu_ps(degrees + i);
+			const auto to = _mm_loadu_ps(dest_degrees + i);
+
+			__m128 distance, direction;
+			shortest_distance_ps(from, to, distance, direction);
+
+			_mm_storeu_ps(degrees + i, _mm_add_ps(from, _mm_mul_ps(_mm_mul_ps(direction, distance), v_t)));
+		}
+#endif
+
+		for (; i < size(); ++i)
+		{
+			angles_[i] = angles_[i].lerp(dest[i], t);
+		}
+	}
+
+	auto AngleBatch::slerp(const std::span<const Angle> dest, const value_type t) const noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(dest.size() >= size());
+
+		size_type i = 0;
+
+#if PB_MATH_ANGLE_BATCH_SSE2
+		auto* degrees = degrees_of(angles_);
+		const auto* dest_degrees = degrees_of(dest);
+
+		const auto v_t = _mm_set1_ps(t);
+		const auto half_turn = _mm_set1_ps(180.f);
+		const auto full_turn = _mm_set1_ps(360.f);
+
+		for (; i < simd_size(size()); i += width)
+		{
+			const auto from = _mm_loadu_ps(degrees + i);
+			const auto to = _mm_loadu_ps(dest_degrees + i);
+
+			const auto diff = _mm_sub_ps(to, from);
+			const auto wrapped = select_ps(_mm_cmpgt_ps(diff, _mm_setzero_ps()), _mm_sub_ps(diff, full_turn), _mm_add_ps(diff, full_turn));
+			const auto shortest = select_ps(_mm_cmplt_ps(abs_ps(diff), half_turn), diff, wrapped);
+
+			_mm_storeu_ps(degrees + i, _mm_add_ps(from, _mm_mul_ps(shortest, v_t)));
+		}
+#endif
+
+		for (; i < size(); ++i)
+		{
+			angles_[i] = angles_[i].slerp(dest[i], t);
+		}
+	}
+
+	auto AngleBatch::sin(const std::span<value_type> out) const noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(out.size() >= size());
+
+		const auto* degrees = degrees_of(angles_);
+		size_type i = 0;
+
+#if PB_MATH_ANGLE_BATCH_SSE2
+		for (; i < simd_size(size()); i += width)
+		{
+			__m128 s, c;
+			sincos_ps(_mm_loadu_ps(degrees + i), s, c);
+
+			_mm_storeu_ps(out.data() + i, s);
+		}
+#endif
+
+		for (; i < size(); ++i)
+		{
+			out[i] = angle_batch_detail::sincos(degrees[i]).first;
+		}
+	}
+
+	auto AngleBatch::cos(const std::span<value_type> out) const noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(out.size() >= size());
+
+		const auto* degrees = degrees_of(angles_);
+		size_type i = 0;
+
+#if PB_MATH_ANGLE_BATCH_SSE2
+		for (; i < simd_size(size()); i += width)
+		{
+			__m128 s, c;
+			sincos_ps(_mm_loadu_ps(degrees + i), s, c);
+
+			_mm_storeu_ps(out.data() + i, c);
+		}
+#endif
+
+		for (; i < size(); ++i)
+		{
+			out[i] = angle_batch_detail::sincos(degrees[i]).second;
+		}
+	}
+
+	auto AngleBatch::sincos(const std::span<value_type> out_sin, const std::span<value_type> out_cos) const noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(out_sin.size() >= size());
+		PB_ERROR_DEBUG_ASSUME(out_cos.size() >= size());
+
+		const auto* degrees = degrees_of(angles_);
+		size_type i = 0;
+
+#if PB_MATH_ANGLE_BATCH_SSE2
+		for (; i < simd_size(size()); i += width)
+		{
+			__m128 s, c;
+			sincos_ps(_mm_loadu_ps(degrees + i), s, c);
+
+			_mm_storeu_ps(out_sin.data() + i, s);
+			_mm_storeu_ps(out_cos.data() + i, c);
+		}
+#endif
+
+		for (; i < size(); ++i)
+		{
+			const auto [s, c] = angle_batch_detail::sincos(degrees[i]);
+
+			out_sin[i] = s;
+			out_cos[i] = c;
+		}
+	}
+
+	auto AngleBatch::to_cartesian(const std::span<glm::vec2> out, const value_type length) const noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(out.size() >= size());
+
+		const auto* degrees = degrees_of(angles_);
+		size_type i = 0;
+
+#if PB_MATH_ANGLE_BATCH_SSE2
+		auto* o = floats_of(out);
+
+		const auto v_length = _mm_set1_ps(length);
+
+		for (; i < simd_size(size()); i += width)
+		{
+			__m128 s, c;
+			sincos_ps(_mm_loadu_ps(degrees + i), s, c);
+
+			store_points(o + i * 2, _mm_mul_ps(v_length, s), _mm_mul_ps(v_length, c));
+		}
+#endif
+
+		for (; i < size(); ++i)
+		{
+			const auto [s, c] = angle_batch_detail::sincos(degrees[i]);
+
+			out[i] = {length * s, length * c};
+		}
+	}
+
+	auto AngleBatch::rotate_point(const std::span<const glm::vec2> point, const std::span<glm::vec2> out) const noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(point.size() >= size());
+		PB_ERROR_DEBUG_ASSUME(out.size() >= size());
+
+		const auto* degrees = degrees_of(angles_);
+		size_type i = 0;
+
+#if PB_MATH_ANGLE_BATCH_SSE2
+		const auto* p = floats_of(point);
+		auto* o = floats_of(out);
+
+		for (; i < simd_size(size()); i += width)
+		{
+			__m128 s, c;
+			sincos_ps(_mm_loadu_ps(degrees + i), s, c);
+
+			__m128 x, y;
+			load_points(p + i * 2, x, y);
+
+			store_points(
+				o + i * 2,
+				_mm_sub_ps(_mm_mul_ps(x, c), _mm_mul_ps(y, s)),
+				_mm_add_ps(_mm_mul_ps(x, s), _mm_mul_ps(y, c))
+			);
+		}
+#endif
+
+		for (; i < size(); ++i)
+		{
+			const auto [s, c] = angle_batch_detail::sincos(degrees[i]);
+			const auto& p = point[i];
+
+			out[i] = {p.x * c - p.y * s, p.x * s + p.y * c};
+		}
+	}
+}
@@ -0,0 +1,251 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <pb/math/kd_tree.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+#include <pb/macro.hpp>
+#include <pb/math/space_filling_curve.hpp>
+#include <pb/platform/os.hpp>
+
+namespace
+{
+	using namespace pb::math;
+
+	using value_type = KDTree::value_type;
+	using size_type = KDTree::size_type;
+	using neighbor_type = KDTree::neighbor_type;
+
+	constexpr neighbor_type no_neighbor{.index = KDTree::invalid_index, .distance_2 = std::numeric_limits<value_type>::infinity()};
+
+	// insert {index, distance_2} into the sorted `out[0, count)`, drops the farthest one if `out` is full
+	auto insert_neighbor(const std::span<neighbor_type> out, std::size_t& count, const size_type index, const value_type distance_2) noexcept -> void
+	{
+		auto i = count < out.size() ? count : out.size() - 1;
+		while (i > 0 and out[i - 1].distance_2 > distance_2)
+		{
+			out[i] = out[i - 1];
+			i -= 1;
+		}
+
+		out[i] = {.index = index, .distance_2 = distance_2};
+		count = std::ranges::min(count + 1, out.size());
+	}
+}
+
+namespace pb::math
+{
+	auto KDTree::build(const size_type begin, const size_type end) -> size_type
+	{
+		const auto node = static_cast<size_type>(nodes_.size());
+		nodes_.push_back({.begin = begin, .end = end, .left = invalid_index, .right = invalid_index, .split = 0, .axis = 0});
+
+		if (end - begin <= bucket_size)
+		{
+			return node;
+		}
+
+		// split the wider axis at its median
+		auto min_x = std::numeric_limits<value_type>::max();
+		auto min_y = std::numeric_limits<value_type>::max();
+		auto max_x = std::numeric_limits<value_type>::lowest();
+		auto max_y = std::numeric_limits<value_type>::lowest();
+		for (auto i = begin; i < end; ++i)
+		{
+			min_x = std::ranges::min(min_x, x_[index_[i]]);
+			max_x = std::ranges::max(max_x, x_[index_[i]]);
+			min_y = std::ranges::min(min_y, y_[index_[i]]);
+			max_y = std::ranges::max(max_y, y_[index_[i]]);
+		}
+
+		const auto axis = max_x - min_x >= max_y - min_y ? 0u : 1u;
+		const auto& coordinates = axis == 0 ? x_ : y_;
+
+		const auto middle = begin + (end - begin) / 2;
+		std::ranges::nth_element(
+			index_.begin() + begin,
+			index_.begin() + middle,
+			index_.begin() + end,
+			[&coordinates](const size_type lhs, const size_type rhs) noexcept -> bool
+			{
+				return coordinates[lhs] < coordinates[rhs];
+			}
+		);
+
+		const auto split = coordinates[index_[middle]];
+
+		const auto left = build(begin, middle);
+		const auto right = build(middle, end);
+
+		// `nodes_` may have been reallocated
+		nodes_[node].left = left;
+		nodes_[node].right = right;
+		nodes_[node].split = split;
+		nodes_[node].axis = axis;
+
+		return node;
+	}
+
+	auto KDTree::search(
+		const size_type node,
+		const value_type x,
+		const value_type y,
+		const std::span<neighbor_type> out,
+		std::size_t& count,
+		value_type& worst_2
+	) const noexcept -> void
+	{
+		const auto& n = nodes_[node];
+
+		if (n.left == invalid_index)
+		{
+			for (auto i = n.begin; i < n.end; ++i)
+			{
+				const auto dx = x_[i] - x;
+				const auto dy = y_[i] - y;
+
+				if (const auto distance_2 = dx * dx + dy * dy;
+					distance_2 < worst_2)
+				{
+					insert_neighbor(out, count, index_[i], distance_2);
+					if (count == out.size())
+					{
+						worst_2 = out[count - 1].distance_2;
+					}
+				}
+			}
+
+			return;
+		}
+
+		const auto delta = (n.axis == 0 ? x : y) - n.split;
+		const auto [near, far] = delta < 0 ? std::pair{n.left, n.right} : std::pair{n.right, n.left};
+
+		search(near, x, y, out, count, worst_2);
+
+		// the far side is at least |delta| away
+		if (delta * delta < worst_2)
+		{
+			search(far, x, y, out, count, worst_2);
+		}
+	}
+
+	KDTree::KDTree(const std::span<const Position> points)
+	{
+		rebuild(points);
+	}
+
+	auto KDTree::rebuild(const std::span<const Position> points) -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(points.size() < invalid_index);
+
+		const auto size = static_cast<size_type>(points.size());
+
+		x_.resize(size);
+		y_.resize(size);
+		index_.resize(size);
+		nodes_.clear();
+
+		for (size_type i = 0; i < size; ++i)
+		{
+			x_[i] = points[i].x();
+			y_[i] = points[i].y();
+		}
+		std::iota(index_.begin(), index_.end(), size_type{0});
+
+		if (size == 0)
+		{
+			return;
+		}
+
+		// a split node holds more than bucket_size points and its halves at least bucket_size / 2,
+		// so there are at most 2n / bucket_size leaves and 4n / bucket_size - 1 nodes
+		nodes_.reserve(4 * size / bucket_size + 1);
+		(void)build(0, size);
+
+		// store the points in tree order, every bucket is contiguous
+		for (size_type i = 0; i < size; ++i)
+		{
+			x_[i] = points[index_[i]].x();
+			y_[i] = points[index_[i]].y();
+		}
+	}
+
+	auto KDTree::size() const noexcept -> std::size_t
+	{
+		return index_.size();
+	}
+
+	auto KDTree::empty() const noexcept -> bool
+	{
+		return index_.empty();
+	}
+
+	auto KDTree::nearest(const Position& query, const std::span<neighbor_type> out, const value_type max_distance_2) const noexcept -> std::size_t
+	{
+		std::ranges::fill(out, no_neighbor);
+
+		if (out.empty() or nodes_.empty())
+		{
+			return 0;
+		}
+
+		std::size_t count = 0;
+		// strictly closer than the current worst, the bound itself is inclusive
+		auto worst_2 = std::nextafter(max_distance_2, std::numeric_limits<value_type>::infinity());
+		search(0, query.x(), query.y(), out, count, worst_2);
+
+		return count;
+	}
+
+	auto KDTree::nearest(const Position& query) const noexcept -> neighbor_type
+	{
+		neighbor_type neighbor;
+		(void)nearest(query, {&neighbor, 1});
+
+		return neighbor;
+	}
+
+	auto KDTree::nearest(
+		const std::span<const Position> queries,
+		const std::span<const size_type> order,
+		const std::size_t k,
+		const std::span<neighbor_type> out,
+		const value_type max_distance_2
+	) const noexcept -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(out.size() >= queries.size() * k);
+
+		for (const auto query: order)
+		{
+			PB_ERROR_DEBUG_ASSUME(query < queries.size());
+
+			(void)nearest(queries[query], out.subspan(query * k, k), max_distance_2);
+		}
+	}
+
+	auto KDTree::nearest(
+		const std::span<const Position> queries,
+		const std::size_t k,
+		const std::span<neighbor_type> out,
+		const value_type max_distance_2
+	) const -> void
+	{
+		const auto order = morton_order(queries);
+
+		nearest(queries, order, k, out, max_distance_2);
+	}
+
+	auto KDTree::morton_order(const std::span<const Position> points) -> std::vector<size_type>
+	{
+		PB_ERROR_DEBUG_ASSUME(points.size() < invalid_index);
+
+		return spatial_order<SpaceFillingCurve::MORTON>(points);
+	}
+}
@@ -0,0 +1,127 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <pb/meta/intern.hpp>
+
+#include <mutex>
+
+namespace pb::infra::meta
+{
+	auto StringInterner::do_find(const std::string_view string, const hash_type hash) const noexcept -> handle_type
+	{
+		const auto it = buckets_.find(hash);
+		if (it == buckets_.end())
+		{
+			return handle_type{};
+		}
+
+		for (auto index = it->second; index != handle_type::invalid_value; index = entries_[index].next)
+		{
+			if (entries_[index].view == string)
+			{
+				return handle_type{index};
+			}
+		}
+
+		return handle_type{};
+	}
+
+	auto StringInterner::intern(const std::string_view string, const hash_type hash) -> handle_type
+	{
+		{
+			const std::shared_lock lock{mutex_};
+
+			if (const auto handle = do_find(string, hash);
+				handle.valid())
+			{
+				return handle;
+			}
+		}
+
+		const std::unique_lock lock{mutex_};
+
+		// someone else may have interned it between the two locks
+		if (const auto handle = do_find(string, hash);
+			handle.valid())
+		{
+			return handle;
+		}
+
+		const auto index = static_cast<value_type>(entries_.size());
+		const std::string_view view = storage_.emplace_back(string);
+
+		// the entry exists before a bucket refers to it, a failed allocation leaves the interner unchanged
+		try
+		{
+			if (const auto it = buckets_.find(hash);
+				it != buckets_.end())
+			{
+				// push front
+				entries_.emplace_back(entry_type{.view = view, .hash = hash, .next = it->second});
+				it->second = index;
+			}
+			else
+			{
+				entries_.emplace_back(entry_type{.view = view, .hash = hash, .next = handle_type::invalid_value});
+				buckets_.emplace(hash, index);
+			}
+		}
+		catch (...)
+		{
+			if (entries_.size() > index)
+			{
+				entries_.pop_back();
+			}
+			storage_.pop_back();
+			throw;
+		}
+
+		return handle_type{index};
+	}
+
+	auto StringInterner::find(const std::string_view string, const hash_type hash) const noexcept -> handle_type
+	{
+		const std::shared_lock lock{mutex_};
+
+		return do_find(string, hash);
+	}
+
+	auto StringInterner::view(const handle_type handle) const noexcept -> std::string_view
+	{
+		const std::shared_lock lock{mutex_};
+
+		if (handle.value() >= entries_.size())
+		{
+			return {};
+		}
+
+		return entries_[handle.value()].view;
+	}
+
+	auto StringInterner::hash(const handle_type handle) const noexcept -> hash_type
+	{
+		const std::shared_lock lock{mutex_};
+
+		if (handle.value() >= entries_.size())
+		{
+			return meta::fnv1a(std::string_view{});
+		}
+
+		return entries_[handle.value()].hash;
+	}
+
+	auto StringInterner::size() const noexcept -> std::size_t
+	{
+		const std::shared_lock lock{mutex_};
+
+		return entries_.size();
+	}
+
+	auto string_interner() noexcept -> StringInterner&
+	{
+		static StringInterner interner{};
+		return interner;
+	}
+}
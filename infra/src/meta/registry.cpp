@@ -0,0 +1,100 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <pb/meta/registry.hpp>
+
+#include <pb/platform/os.hpp>
+
+namespace pb::infra::meta
+{
+	auto TypeRegistry::reserve(const hash_type hash, const std::string_view name) -> std::pair<type_id_type, bool>
+	{
+		const auto id = static_cast<type_id_type>(types_.size());
+
+		if (const auto [it, inserted] = hash_to_id_.try_emplace(hash, id);
+			not inserted)
+		{
+			return {it->second, false};
+		}
+
+		types_.emplace_back(
+			TypeDescriptor{
+					.id = id,
+					.category = TypeCategory::OPAQUE,
+					.hash = hash,
+					.name = name,
+					.size = 0,
+					.alignment = 0,
+					.member_offset = static_cast<std::uint32_t>(members_.size()),
+					.member_count = 0,
+					.enumerator_offset = static_cast<std::uint32_t>(enumerators_.size()),
+					.enumerator_count = 0
+			}
+		);
+
+		return {id, true};
+	}
+
+	auto TypeRegistry::types() const noexcept -> std::span<const TypeDescriptor>
+	{
+		return types_;
+	}
+
+	auto TypeRegistry::members() const noexcept -> std::span<const MemberDescriptor>
+	{
+		return members_;
+	}
+
+	auto TypeRegistry::enumerators() const noexcept -> std::span<const EnumeratorDescriptor>
+	{
+		return enumerators_;
+	}
+
+	auto TypeRegistry::members_of(const TypeDescriptor& descriptor) const noexcept -> std::span<const MemberDescriptor>
+	{
+		PB_ERROR_DEBUG_ASSUME(descriptor.member_offset + descriptor.member_count <= members_.size());
+
+		return members().subspan(descriptor.member_offset, descriptor.member_count);
+	}
+
+	auto TypeRegistry::enumerators_of(const TypeDescriptor& descriptor) const noexcept -> std::span<const EnumeratorDescriptor>
+	{
+		PB_ERROR_DEBUG_ASSUME(descriptor.enumerator_offset + descriptor.enumerator_count <= enumerators_.size());
+
+		return enumerators().subspan(descriptor.enumerator_offset, descriptor.enumerator_count);
+	}
+
+	auto TypeRegistry::type_of(const type_id_type id) const noexcept -> const TypeDescriptor*
+	{
+		if (id >= types_.size())
+		{
+			return nullptr;
+		}
+
+		return types_.data() + id;
+	}
+
+	auto TypeRegistry::find(const hash_type hash) const noexcept -> const TypeDescriptor*
+	{
+		if (const auto it = hash_to_id_.find(hash);
+			it != hash_to_id_.end())
+		{
+			return type_of(it->second);
+		}
+
+		return nullptr;
+	}
+
+	auto TypeRegistry::find(const std::string_view name) const noexcept -> const TypeDescriptor*
+	{
+		return find(meta::type_hash(name));
+	}
+
+	auto type_registry() noexcept -> TypeRegistry&
+	{
+		static TypeRegistry registry{};
+		return registry;
+	}
+}
@@ -0,0 +1,42 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <pb/meta/type_id.hpp>
+
+#if PB_COMPILER_DEBUG
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <pb/platform/os.hpp>
+
+namespace pb::infra::meta::type_id_detail
+{
+	auto check_collision(const hash_type hash, const std::string_view name) noexcept -> bool
+	{
+		static std::mutex mutex{};
+		static std::unordered_map<hash_type, std::string_view> checked{};
+
+		const std::scoped_lock lock{mutex};
+
+		if (const auto [it, inserted] = checked.try_emplace(hash, name);
+			not inserted and it->second != name)
+		{
+			std::string message{"type hash collision: `"};
+			message.append(it->second);
+			message.append("` <=> `");
+			message.append(name);
+			message.append("`");
+			platform::write_debug_message(message);
+
+			PB_ERROR_DEBUG_UNREACHABLE("type hash collision");
+		}
+
+		return true;
+	}
+}
+
+#endif
@@ -0,0 +1,210 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <pb/platform/file_watcher.hpp>
+
+#include <algorithm>
+#include <array>
+#include <ranges>
+#include <system_error>
+
+#include <pb/platform/os.hpp>
+
+#if defined(PB_PLATFORM_LINUX)
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	struct location_type
+	{
+		std::string directory;
+		std::string name;
+	};
+
+	[[nodiscard]] auto location_of(const std::filesystem::path& path) -> location_type
+	{
+		std::error_code error;
+		auto absolute = std::filesystem::absolute(path, error);
+		if (error)
+		{
+			absolute = path;
+		}
+		absolute = absolute.lexically_normal();
+
+		return {.directory = absolute.parent_path().string(), .name = absolute.filename().string()};
+	}
+
+	[[nodiscard]] auto last_write_time_of(const std::filesystem::path& path) noexcept -> std::filesystem::file_time_type
+	{
+		std::error_code error;
+		const auto time = std::filesystem::last_write_time(path, error);
+		return error ? std::filesystem::file_time_type::min() : time;
+	}
+
+	auto report(std::vector<std::filesystem::path>& changed, const std::filesystem::path& path) -> void
+	{
+		if (std::ranges::find(changed, path) == changed.end())
+		{
+			changed.push_back(path);
+		}
+	}
+}
+
+namespace pb::infra::platform
+{
+	FileWatcher::FileWatcher()
+		: descriptor_{-1},
+		  last_scan_{std::chrono::steady_clock::now()}
+	{
+#if defined(PB_PLATFORM_LINUX)
+		descriptor_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (descriptor_ == -1)
+		{
+			OsError::panic();
+		}
+#endif
+	}
+
+	FileWatcher::~FileWatcher() noexcept
+	{
+#if defined(PB_PLATFORM_LINUX)
+		// closing the instance removes all its watches
+		close(descriptor_);
+#endif
+	}
+
+	auto FileWatcher::watch(const std::filesystem::path& path) -> bool
+	{
+		auto [directory, name] = location_of(path);
+
+		auto it = directories_.find(directory);
+		if (it == directories_.end())
+		{
+			int watch = -1;
+#if defined(PB_PLATFORM_LINUX)
+			// IN_CLOSE_WRITE: written in place, IN_MOVED_TO: replaced by a rename
+			watch = inotify_add_watch(descriptor_, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+			if (watch == -1)
+			{
+				return false;
+			}
+
+			watches_.emplace(watch, directory);
+#endif
+
+			it = directories_.emplace(std::move(directory), directory_type{.watch = watch, .files = {}}).first;
+		}
+
+		it->second.files.insert_or_assign(std::move(name), file_type{.path = path, .time = last_write_time_of(path)});
+		return true;
+	}
+
+	auto FileWatcher::unwatch(const std::filesystem::path& path) -> void
+	{
+		const auto [directory, name] = location_of(path);
+
+		const auto it = directories_.find(directory);
+		if (it == directories_.end())
+		{
+			return;
+		}
+
+		it->second.files.erase(name);
+		if (not it->second.files.empty())
+		{
+			return;
+		}
+
+#if defined(PB_PLATFORM_LINUX)
+		inotify_rm_watch(descriptor_, it->second.watch);
+		watches_.erase(it->second.watch);
+#endif
+		directories_.erase(it);
+	}
+
+	auto FileWatcher::poll(std::vector<std::filesystem::path>& changed) -> void
+	{
+#if defined(PB_PLATFORM_LINUX)
+		alignas(inotify_event) std::array<char, 4096> buffer; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+		while (true)
+		{
+			const ssize_t length = read(descriptor_, buffer.data(), buffer.size());
+			// EAGAIN: no more events
+			if (length <= 0)
+			{
+				break;
+			}
+
+			for (ssize_t offset = 0; offset < length;)
+			{
+				const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+				offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+				// events were dropped, assume everything changed
+				if (event->mask & IN_Q_OVERFLOW)
+				{
+					for (const auto& directory: directories_ | std::views::values)
+					{
+						for (const auto& file: directory.files | std::views::values)
+						{
+							report(changed, file.path);
+						}
+					}
+					continue;
+				}
+
+				const auto watch = watches_.find(event->wd);
+				if (watch == watches_.end())
+				{
+					continue;
+				}
+
+				// the directory was removed
+				if (event->mask & IN_IGNORED)
+				{
+					directories_.erase(watch->second);
+					watches_.erase(watch);
+					continue;
+				}
+
+				if (event->len == 0)
+				{
+					continue;
+				}
+
+				const auto& files = directories_[watch->second].files;
+				if (const auto file = files.find(std::string{event->name});
+					file != files.end())
+				{
+					report(changed, file->second.path);
+				}
+			}
+		}
+#else
+		const auto now = std::chrono::steady_clock::now();
+		if (now - last_scan_ < scan_interval)
+		{
+			return;
+		}
+		last_scan_ = now;
+
+		for (auto& directory: directories_ | std::views::values)
+		{
+			for (auto& file: directory.files | std::views::values)
+			{
+				if (const auto time = last_write_time_of(file.path);
+					time != file.time)
+				{
+					file.time = time;
+					report(changed, file.path);
+				}
+			}
+		}
+#endif
+	}
+}
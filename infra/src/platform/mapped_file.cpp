@@ -0,0 +1,166 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <pb/platform/mapped_file.hpp>
+
+#include <utility>
+
+#include <pb/platform/os.hpp>
+
+#if defined(PB_PLATFORM_WINDOWS)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace pb::infra::platform
+{
+	auto MappedFile::unmap() noexcept -> void
+	{
+		if (data_ != nullptr)
+		{
+#if defined(PB_PLATFORM_WINDOWS)
+			UnmapViewOfFile(data_);
+#else
+			munmap(const_cast<std::byte*>(data_), size_);
+#endif
+		}
+
+		data_ = nullptr;
+		size_ = 0;
+	}
+
+	MappedFile::MappedFile() noexcept
+		: data_{nullptr},
+		  size_{0} {}
+
+	MappedFile::MappedFile(const std::filesystem::path& path)
+		: MappedFile{}
+	{
+#if defined(PB_PLATFORM_WINDOWS)
+		const auto file = CreateFileW(
+			path.c_str(),
+			GENERIC_READ,
+			FILE_SHARE_READ,
+			nullptr,
+			OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS,
+			nullptr
+		);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			OsError::panic();
+		}
+
+		LARGE_INTEGER size;
+		if (GetFileSizeEx(file, &size) == FALSE)
+		{
+			CloseHandle(file);
+			OsError::panic();
+		}
+
+		// an empty file cannot be mapped
+		if (size.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return;
+		}
+
+		const auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(file);
+		if (mapping == nullptr)
+		{
+			OsError::panic();
+		}
+
+		// the view keeps the mapping object alive
+		const auto* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		CloseHandle(mapping);
+		if (view == nullptr)
+		{
+			OsError::panic();
+		}
+
+		data_ = static_cast<const std::byte*>(view);
+		size_ = static_cast<size_type>(size.QuadPart);
+#else
+		const auto file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (file == -1)
+		{
+			OsError::panic();
+		}
+
+		struct stat status{};
+		if (fstat(file, &status) == -1)
+		{
+			close(file);
+			OsError::panic();
+		}
+
+		// an empty file cannot be mapped
+		if (status.st_size == 0)
+		{
+			close(file);
+			return;
+		}
+
+		// the mapping keeps the file alive
+		auto* view = mmap(nullptr, static_cast<size_type>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+		close(file);
+		if (view == MAP_FAILED)
+		{
+			OsError::panic();
+		}
+
+		data_ = static_cast<const std::byte*>(view);
+		size_ = static_cast<size_type>(status.st_size);
+#endif
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+		: data_{std::exchange(other.data_, nullptr)},
+		  size_{std::exchange(other.size_, 0)} {}
+
+	auto MappedFile::operator=(MappedFile&& other) noexcept -> MappedFile&
+	{
+		if (this != &other)
+		{
+			unmap();
+
+			data_ = std::exchange(other.data_, nullptr);
+			size_ = std::exchange(other.size_, 0);
+		}
+
+		return *this;
+	}
+
+	MappedFile::~MappedFile() noexcept
+	{
+		unmap();
+	}
+
+	auto MappedFile::empty() const noexcept -> bool
+	{
+		return size_ == 0;
+	}
+
+	auto MappedFile::size() const noexcept -> size_type
+	{
+		return size_;
+	}
+
+	auto MappedFile::data() const noexcept -> const std::byte*
+	{
+		return data_;
+	}
+
+	auto MappedFile::bytes() const noexcept -> std::span<const std::byte>
+	{
+		return {data_, size_};
+	}
+}
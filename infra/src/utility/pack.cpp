@@ -0,0 +1,372 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <pb/utility/pack.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <exception>
+#include <format>
+#include <fstream>
+#include <numeric>
+#include <system_error>
+
+#include <pb/macro.hpp>
+#include <pb/platform/os.hpp>
+
+namespace
+{
+	using namespace pb::infra;
+	using namespace utility;
+
+	static_assert(std::endian::native == std::endian::little, "the pack format is little endian");
+
+	[[nodiscard]] constexpr auto align_up(const std::uint64_t value, const std::uint64_t alignment) noexcept -> std::uint64_t
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	[[nodiscard]] auto read_file(const std::filesystem::path& path) -> std::vector<std::byte>
+	{
+		std::ifstream file{path, std::ios::binary | std::ios::ate};
+		if (not file.is_open())
+		{
+			PackError::panic(std::format("cannot open '{}'", path.string()));
+		}
+
+		std::vector<std::byte> data(static_cast<std::size_t>(file.tellg()));
+		file.seekg(0);
+		if (not file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size())))
+		{
+			PackError::panic(std::format("cannot read '{}'", path.string()));
+		}
+
+		return data;
+	}
+
+	template<typename T>
+	auto write_span(std::ofstream& file, const std::span<const T> data) -> void
+	{
+		file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size_bytes()));
+	}
+}
+
+namespace pb::infra::utility
+{
+	auto Pack::make_entry(const pack_detail::entry_type& entry) const noexcept -> PackEntry
+	{
+		return {
+				.path = strings_.substr(entry.path_offset, entry.path_size),
+				.data = file_.bytes().subspan(static_cast<std::size_t>(entry.offset), static_cast<std::size_t>(entry.size)),
+				.compression = entry.compression,
+				.original_size = entry.original_size
+		};
+	}
+
+	auto Pack::normalize(const std::filesystem::path& path) -> std::string
+	{
+		return path.lexically_normal().generic_string();
+	}
+
+	auto Pack::hash_of(const std::string_view normalized_path) noexcept -> meta::hash_type
+	{
+		return meta::fnv1a(normalized_path);
+	}
+
+	Pack::Pack() noexcept
+		: header_{nullptr} {}
+
+	Pack::Pack(const std::filesystem::path& path)
+		: Pack{}
+	{
+		try
+		{
+			file_ = platform::MappedFile{path};
+		}
+		catch (const platform::OsError& error)
+		{
+			PackError::panic(std::format("cannot map '{}': {}", path.string(), error.what()));
+		}
+
+		const auto bytes = file_.bytes();
+		const auto in_file = [size = static_cast<std::uint64_t>(bytes.size())](const std::uint64_t offset, const std::uint64_t length) noexcept -> bool
+		{
+			return offset <= size and length <= size - offset;
+		};
+
+		if (bytes.size() < sizeof(pack_detail::header_type))
+		{
+			PackError::panic(std::format("'{}' is not a pack", path.string()));
+		}
+
+		// the mapping is page aligned
+		header_ = reinterpret_cast<const pack_detail::header_type*>(bytes.data());
+		const auto& header = *header_;
+
+		if (header.magic != pack_detail::magic)
+		{
+			PackError::panic(std::format("'{}' is not a pack", path.string()));
+		}
+		if (header.version != pack_detail::version)
+		{
+			PackError::panic(std::format("'{}' has version {}, expected {}", path.string(), header.version, pack_detail::version));
+		}
+		// at least one empty bucket terminates every probe
+		if (not std::has_single_bit(header.bucket_count) or header.bucket_count <= header.entry_count)
+		{
+			PackError::panic(std::format("'{}' has an invalid bucket count {}", path.string(), header.bucket_count));
+		}
+		if (
+			header.entry_offset % alignof(pack_detail::entry_type) != 0 or
+			header.bucket_offset % alignof(std::uint32_t) != 0 or
+			not in_file(header.entry_offset, static_cast<std::uint64_t>(header.entry_count) * sizeof(pack_detail::entry_type)) or
+			not in_file(header.bucket_offset, static_cast<std::uint64_t>(header.bucket_count) * sizeof(std::uint32_t)) or
+			not in_file(header.string_offset, 0)
+		)
+		{
+			PackError::panic(std::format("'{}' has an invalid table of contents", path.string()));
+		}
+
+		entries_ = {reinterpret_cast<const pack_detail::entry_type*>(bytes.data() + header.entry_offset), header.entry_count};
+		buckets_ = {reinterpret_cast<const std::uint32_t*>(bytes.data() + header.bucket_offset), header.bucket_count};
+		strings_ = {reinterpret_cast<const char*>(bytes.data() + header.string_offset), static_cast<std::size_t>(bytes.size() - header.string_offset)};
+
+		// validate everything once, `find` / `entry` do not check anything
+		for (const auto& entry: entries_)
+		{
+			if (
+				not in_file(entry.offset, entry.size) or
+				static_cast<std::uint64_t>(entry.path_offset) + entry.path_size > strings_.size() or
+				entry.compression > PackCompression::ZSTD
+			)
+			{
+				PackError::panic(std::format("'{}' has an invalid entry", path.string()));
+			}
+		}
+
+		for (const auto bucket: buckets_)
+		{
+			if (bucket != pack_detail::empty_bucket and bucket >= header.entry_count)
+			{
+				PackError::panic(std::format("'{}' has an invalid bucket", path.string()));
+			}
+		}
+	}
+
+	auto Pack::size() const noexcept -> size_type
+	{
+		return static_cast<size_type>(entries_.size());
+	}
+
+	auto Pack::entry(const size_type index) const noexcept -> PackEntry
+	{
+		PB_ERROR_DEBUG_ASSUME(index < entries_.size());
+
+		return make_entry(entries_[index]);
+	}
+
+	auto Pack::find(const std::string_view path) const noexcept -> std::optional<PackEntry>
+	{
+		if (buckets_.empty())
+		{
+			return std::nullopt;
+		}
+
+		const auto hash = hash_of(path);
+		const auto mask = buckets_.size() - 1;
+
+		for (auto bucket = static_cast<std::size_t>(hash) & mask;; bucket = (bucket + 1) & mask)
+		{
+			const auto index = buckets_[bucket];
+			if (index == pack_detail::empty_bucket)
+			{
+				return std::nullopt;
+			}
+
+			if (const auto& entry = entries_[index];
+				entry.hash == hash and strings_.substr(entry.path_offset, entry.path_size) == path)
+			{
+				return make_entry(entry);
+			}
+		}
+	}
+
+	auto Pack::find(const std::filesystem::path& path) const -> std::optional<PackEntry>
+	{
+		return find(std::string_view{normalize(path)});
+	}
+
+	auto PackWriter::add(const std::filesystem::path& path, std::filesystem::path source) -> void
+	{
+		files_.emplace_back(Pack::normalize(path), std::move(source), std::vector<std::byte>{});
+	}
+
+	auto PackWriter::add(const std::filesystem::path& path, std::vector<std::byte> data) -> void
+	{
+		files_.emplace_back(Pack::normalize(path), std::filesystem::path{}, std::move(data));
+	}
+
+	auto PackWriter::size() const noexcept -> size_type
+	{
+		return static_cast<size_type>(files_.size());
+	}
+
+	auto PackWriter::write(const std::filesystem::path& destination, const size_type alignment) const -> void
+	{
+		PB_ERROR_DEBUG_ASSUME(std::has_single_bit(alignment));
+
+		// sorted by path, the output does not depend on the order of `add`
+		std::vector<std::size_t> order(files_.size());
+		std::iota(order.begin(), order.end(), std::size_t{0});
+		std::ranges::sort(order, {}, [this](const std::size_t index) noexcept -> const std::string& { return files_[index].path; });
+
+		if (const auto it = std::ranges::adjacent_find(order, {}, [this](const std::size_t index) noexcept -> const std::string& { return files_[index].path; });
+			it != order.end())
+		{
+			PackError::panic(std::format("duplicate path '{}'", files_[*it].path));
+		}
+
+		const auto entry_count = static_cast<std::uint32_t>(files_.size());
+		const auto bucket_count = std::bit_ceil(entry_count * 2 + 1);
+
+		pack_detail::header_type header{
+				.magic = pack_detail::magic,
+				.version = pack_detail::version,
+				.entry_count = entry_count,
+				.bucket_count = bucket_count,
+				.alignment = alignment,
+				.reserved = 0,
+				.entry_offset = sizeof(pack_detail::header_type),
+				.bucket_offset = sizeof(pack_detail::header_type) + static_cast<std::uint64_t>(entry_count) * sizeof(pack_detail::entry_type),
+				.string_offset = 0
+		};
+		header.string_offset = header.bucket_offset + static_cast<std::uint64_t>(bucket_count) * sizeof(std::uint32_t);
+
+		std::string strings;
+		std::vector<pack_detail::entry_type> entries;
+		std::vector<std::uint32_t> buckets(bucket_count, pack_detail::empty_bucket);
+
+		entries.reserve(entry_count);
+		for (const auto index: order)
+		{
+			const auto& file = files_[index];
+
+			std::uint64_t size = file.data.size();
+			if (not file.source.empty())
+			{
+				std::error_code error;
+				size = std::filesystem::file_size(file.source, error);
+				if (error)
+				{
+					PackError::panic(std::format("cannot read '{}': {}", file.source.string(), error.message()));
+				}
+			}
+
+			const auto entry_index = static_cast<std::uint32_t>(entries.size());
+			const auto hash = Pack::hash_of(file.path);
+
+			entries.push_back({
+					.hash = hash,
+					// relative to the data, fixed below
+					.offset = 0,
+					.size = size,
+					.original_size = size,
+					.path_offset = static_cast<std::uint32_t>(strings.size()),
+					.path_size = static_cast<std::uint32_t>(file.path.size()),
+					.compression = PackCompression::NONE,
+					.reserved = {}
+			});
+			strings.append(file.path);
+
+			auto bucket = static_cast<std::size_t>(hash) & (bucket_count - 1);
+			while (buckets[bucket] != pack_detail::empty_bucket)
+			{
+				bucket = (bucket + 1) & (bucket_count - 1);
+			}
+			buckets[bucket] = entry_index;
+		}
+
+		auto offset = align_up(header.string_offset + strings.size(), alignment);
+		for (auto& entry: entries)
+		{
+			entry.offset = offset;
+			offset = align_up(offset + entry.size, alignment);
+		}
+
+		// write next to the destination and replace it at once, readers never see a partially written pack.
+		// POSIX only: the old pack may still be mapped (e.g. by a running game), it stays valid until unmapped.
+		// Windows cannot replace a file with a mapped view, the rename fails while a `Pack` over `destination` is alive.
+		auto temporary = destination;
+		temporary += ".tmp";
+
+		try
+		{
+			{
+				std::ofstream file{temporary, std::ios::binary | std::ios::trunc};
+				if (not file.is_open())
+				{
+					PackError::panic(std::format("cannot create '{}'", temporary.string()));
+				}
+
+				write_span(file, std::span<const pack_detail::header_type>{&header, 1});
+				write_span(file, std::span<const pack_detail::entry_type>{entries});
+				write_span(file, std::span<const std::uint32_t>{buckets});
+				write_span(file, std::span<const char>{strings});
+
+				const std::array<char, 256> padding{};
+				auto position = header.string_offset + strings.size();
+
+				for (std::size_t i = 0; i < order.size(); ++i)
+				{
+					const auto& source = files_[order[i]];
+					const auto& entry = entries[i];
+
+					for (auto gap = entry.offset - position; gap != 0;)
+					{
+						const auto count = std::ranges::min(gap, std::uint64_t{padding.size()});
+						file.write(padding.data(), static_cast<std::streamsize>(count));
+						gap -= count;
+					}
+
+					if (source.source.empty())
+					{
+						write_span(file, std::span<const std::byte>{source.data});
+					}
+					else
+					{
+						const auto data = read_file(source.source);
+						if (data.size() != entry.size)
+						{
+							PackError::panic(std::format("'{}' changed while packing", source.source.string()));
+						}
+
+						write_span(file, std::span<const std::byte>{data});
+					}
+
+					position = entry.offset + entry.size;
+				}
+
+				if (not file.flush())
+				{
+					PackError::panic(std::format("cannot write '{}'", temporary.string()));
+				}
+			}
+
+			std::error_code error;
+			std::filesystem::rename(temporary, destination, error);
+			if (error)
+			{
+				PackError::panic(std::format("cannot replace '{}': {}", destination.string(), error.message()));
+			}
+		}
+		catch (...)
+		{
+			// do not leave a partial pack behind
+			std::error_code error;
+			std::filesystem::remove(temporary, error);
+			throw;
+		}
+	}
+}
@@ -0,0 +1,109 @@
+// This file is part of ProjectBlur
+// Copyright (C) 2022-2025 Life4gal <life4gal@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <ciso646>
+#include <bit>
+#include <charconv>
+#include <cstdio>
+#include <filesystem>
+#include <print>
+#include <span>
+#include <string_view>
+#include <system_error>
+
+#include <pb/utility/pack.hpp>
+
+namespace
+{
+	auto usage() -> void
+	{
+		std::println(stderr, "usage: pb-pack [--align <power of two>] <output> <file or directory>...");
+		std::println(stderr, "    every file is stored under its path as given (directories are walked recursively), e.g. `pb-pack game.pbpack assets`");
+		std::println(stderr, "    stores `assets/player.png`, the same path the game loads.");
+	}
+}
+
+auto main(const int argc, char* argv[]) -> int
+{
+	using pb::infra::utility::PackWriter;
+	using pb::infra::utility::PackError;
+
+	const std::span args{argv + 1, static_cast<std::size_t>(argc - 1)};
+
+	auto alignment = PackWriter::default_alignment;
+	std::size_t first = 0;
+
+	if (args.size() >= 2 and std::string_view{args[0]} == "--align")
+	{
+		const std::string_view value{args[1]};
+		if (const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), alignment);
+			error != std::errc{} or end != value.data() + value.size() or not std::has_single_bit(alignment))
+		{
+			std::println(stderr, "invalid alignment '{}'", value);
+			return -1;
+		}
+
+		first = 2;
+	}
+
+	if (args.size() < first + 2)
+	{
+		usage();
+		return -1;
+	}
+
+	const std::filesystem::path output{args[first]};
+
+	PackWriter writer;
+	for (const auto* input: args.subspan(first + 1))
+	{
+		const std::filesystem::path path{input};
+
+		std::error_code error;
+		if (std::filesystem::is_directory(path, error))
+		{
+			// the non-throwing overloads, an unreadable subdirectory is reported below
+			for (
+				std::filesystem::recursive_directory_iterator it{path, error}, end;
+				not error and it != end;
+				it.increment(error)
+			)
+			{
+				if (it->is_regular_file(error))
+				{
+					writer.add(it->path(), it->path());
+				}
+			}
+		}
+		else if (std::filesystem::is_regular_file(path, error))
+		{
+			writer.add(path, path);
+		}
+		else
+		{
+			std::println(stderr, "'{}' is not a file or directory", path.string());
+			return -2;
+		}
+
+		if (error)
+		{
+			std::println(stderr, "cannot read '{}': {}", path.string(), error.message());
+			return -2;
+		}
+	}
+
+	try
+	{
+		writer.write(output, alignment);
+	}
+	catch (const PackError& error)
+	{
+		std::println(stderr, "{}", error.what());
+		return -3;
+	}
+
+	std::println("packed {} files into '{}'", writer.size(), output.string());
+	return 0;
+}